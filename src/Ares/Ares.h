@@ -23,12 +23,15 @@
  * @section core Core Engine Components
  * - Core.h: Essential engine functions and types.
  * - Application.h: Base application class.
+ * - Bounds.h: Bounding boxes, spheres, rays and frustums with their intersection tests.
  * - Flags.h: Flags for configuration and settings.
  * - Input.h: Input handling.
  * - Layer.h: Base layer class.
  * - MainThreadQueue.h: Main thread task queue for renderer commands and other tasks.
+ * - SIMD.h: Compile-time detection of SSE/AVX support.
  * - ThreadPool.h: Multi-threading support for background tasks.
  * - Timestep.h: Time step calculations.
+ * - TypeID.h: Dense, RTTI-free type ids.
  * - Utility.h: Utility functions.
  * - Window.h: Base window class.
  * 
@@ -36,19 +39,33 @@
  * - Asset.h: Base asset class and data structure.
  * - AssetManager.h: Asset management system for loading and caching assets.
  * - DataBuffer.h: Data buffer utilities for managing raw data.
+ * - MappedFile.h: Read-only memory-mapped file access.
  * - MemoryDataProvider.h: Data provider that fetches data from memory.
  * - RawData.h: Raw data structure.
  * 
  * @section ecs Entity Component System (ECS)
  * - Component.h: Base class for ECS components.
  * - Entity.h: Entity class representing game objects.
+ * - Archetype.h: Chunked component storage for entities sharing a component set.
+ * - EntityCommandBuffer.h: Deferred structural changes, played back once per frame.
+ * - EntityID.h: Packing of entity slot indices and generations into entity ids.
  * - EntityManager.h: Manages entities and component storage.
+ * - Prefab.h: Prototype component sets, instantiated in bulk.
  * - Scene.h: Represents a scene containing entities and systems.
+ * - SceneSerializer.h: Saves & loads entities to binary scene files.
+ * - SceneSnapshot.h: In-memory scene snapshots and compact deltas between them.
+ * - View.h: Typed query over entities that have a given set of components, with Changed & Added filters.
  * - System.h: Base class for ECS systems:
+ * - SystemScheduler.h: Runs non-conflicting systems in parallel on the thread pool.
  * - AllComponents.h: Includes all ECS component headers.
+ * - Hierarchy.h: Parent & Children components forming the scene hierarchy.
+ * - Occluder.h: Low polygon occluder geometry for the RenderSystem's occlusion culling.
  * - CameraSystem.h: ECS system handling camera components.
+ * - LODSystem.h: ECS system picking mesh levels of detail from their projected size.
  * - LightSystem.h: ECS system for managing light components.
  * - RenderSystem.h: ECS system responsible for rendering entities.
+ * - SpatialIndexSystem.h: ECS system keeping an AABB tree of entity bounds for spatial queries.
+ * - TransformSystem.h: ECS system computing local & world transformation matrices.
  * 
  * @section events Event Handling
  * - ApplicationEvent.h: Events related to the application lifecycle.
@@ -72,7 +89,9 @@
  * - Texture.h: Texture handling and loading.
  * - Buffer.h: Buffer management for GPU data.
  * - BufferLayout.h: Defines buffer layouts for vertex data.
+ * - CountingVertexBuffer.h: Vertex buffer counting uploaded bytes, for measuring streaming.
  * - FrameBuffer.h: Framebuffer management for offscreen rendering.
+ * - OcclusionBuffer.h: CPU depth-only rasterizer with a hierarchical-Z pyramid for occlusion culling.
  * - UniformBuffer.h: Uniform buffer handling for shader data.
  * - VertexArray.h: Vertex array object management for rendering.h
  */
@@ -85,30 +104,45 @@
 #include "Engine/Debug/Log.h"
 
 #include "Engine/Core/Application.h"
+#include "Engine/Core/Bounds.h"
 #include "Engine/Core/Flags.h"
+#include "Engine/Core/FlatMap.h"
 #include "Engine/Core/Input.h"
 #include "Engine/Core/Layer.h"
 #include "Engine/Core/MainThreadQueue.h"
+#include "Engine/Core/SIMD.h"
 #include "Engine/Core/ThreadPool.h"
 #include "Engine/Core/Timestep.h"
+#include "Engine/Core/TypeID.h"
 #include "Engine/Core/Utility.h"
 #include "Engine/Core/Window.h"
 
 #include "Engine/Data/Asset.h"
 #include "Engine/Data/AssetManager.h"
 #include "Engine/Data/DataBuffer.h"
+#include "Engine/Data/MappedFile.h"
 #include "Engine/Data/MemoryDataProvider.h"
+#include "Engine/Data/MeshSimplifier.h"
 #include "Engine/Data/RawData.h"
 
 #include "Engine/ECS/Core/Component.h"
 #include "Engine/ECS/Core/Entity.h"
+#include "Engine/ECS/Core/EntityCommandBuffer.h"
 #include "Engine/ECS/Core/EntityManager.h"
+#include "Engine/ECS/Core/Prefab.h"
 #include "Engine/ECS/Core/Scene.h"
+#include "Engine/ECS/Core/SceneSerializer.h"
+#include "Engine/ECS/Core/SceneSnapshot.h"
 #include "Engine/ECS/Core/System.h"
+#include "Engine/ECS/Core/SystemScheduler.h"
+#include "Engine/ECS/Core/View.h"
 #include "Engine/ECS/Components/AllComponents.h"
 #include "Engine/ECS/Systems/CameraSystem.h"
+#include "Engine/ECS/Systems/LODSystem.h"
 #include "Engine/ECS/Systems/LightSystem.h"
 #include "Engine/ECS/Systems/RenderSystem.h"
+#include "Engine/ECS/Systems/SpatialIndexSystem.h"
+#include "Engine/ECS/Systems/TransformSystem.h"
 
 #include "Engine/Events/ApplicationEvent.h"
 #include "Engine/Events/AssetEvent.h"
@@ -133,6 +167,11 @@
 
 #include "Engine/Renderer/Buffer.h"
 #include "Engine/Renderer/BufferLayout.h"
+#include "Engine/Renderer/CountingVertexBuffer.h"
 #include "Engine/Renderer/FrameBuffer.h"
+#include "Engine/Renderer/FrameRingAllocator.h"
+#include "Engine/Renderer/OcclusionBuffer.h"
+#include "Engine/Renderer/RenderQueue.h"
+#include "Engine/Renderer/ShaderUniforms.h"
 #include "Engine/Renderer/UniformBuffer.h"
 #include "Engine/Renderer/VertexArray.h"
\ No newline at end of file
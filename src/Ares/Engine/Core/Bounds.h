@@ -0,0 +1,236 @@
+/**
+ * @file Bounds.h
+ * @brief Defines bounding volumes, rays and view frustums with their intersection tests.
+ *
+ * @details These are the shapes used by spatial queries (culling, picking and proximity checks).
+ * Everything is plain data with inline tests, so the types can be stored in bulk and tested in
+ * tight loops.
+ */
+#pragma once
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+namespace Ares {
+
+	/**
+	 * @struct AABB
+	 * @brief An axis-aligned bounding box.
+	 *
+	 * @details A default constructed box is empty (invalid) and grows to fit whatever is
+	 * merged into it.
+	 */
+	struct AABB
+	{
+		glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 Max = glm::vec3(std::numeric_limits<float>::lowest());
+
+		AABB() = default;
+		AABB(const glm::vec3& min, const glm::vec3& max)
+			: Min(min), Max(max)
+		{
+		}
+
+		/**
+		 * @brief Checks if the box contains anything.
+		 */
+		inline bool IsValid() const { return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z; }
+
+		inline glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+		inline glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+		/**
+		 * @brief Gets the surface area of the box, the cost metric of bounding volume hierarchies.
+		 */
+		inline float GetSurfaceArea() const
+		{
+			const glm::vec3 size = Max - Min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		/**
+		 * @brief Grows the box to include a point.
+		 */
+		inline void Merge(const glm::vec3& point)
+		{
+			Min = glm::min(Min, point);
+			Max = glm::max(Max, point);
+		}
+
+		/**
+		 * @brief Grows the box to include another box.
+		 */
+		inline void Merge(const AABB& other)
+		{
+			Min = glm::min(Min, other.Min);
+			Max = glm::max(Max, other.Max);
+		}
+
+		/**
+		 * @brief Grows the box by a margin on every side.
+		 */
+		inline AABB Expanded(const float margin) const
+		{
+			return AABB(Min - glm::vec3(margin), Max + glm::vec3(margin));
+		}
+
+		inline bool Contains(const AABB& other) const
+		{
+			return Min.x <= other.Min.x && Min.y <= other.Min.y && Min.z <= other.Min.z &&
+				Max.x >= other.Max.x && Max.y >= other.Max.y && Max.z >= other.Max.z;
+		}
+
+		inline bool Intersects(const AABB& other) const
+		{
+			return Min.x <= other.Max.x && Max.x >= other.Min.x &&
+				Min.y <= other.Max.y && Max.y >= other.Min.y &&
+				Min.z <= other.Max.z && Max.z >= other.Min.z;
+		}
+
+		/**
+		 * @brief Gets the box around this box after it's transformed by a matrix.
+		 *
+		 * @details Transforms the center and projects the extents onto the absolute axes of the
+		 * matrix, which is exact for the 8 corners without transforming each of them.
+		 *
+		 * @param matrix An affine transformation matrix.
+		 */
+		inline AABB Transformed(const glm::mat4& matrix) const
+		{
+			if (!IsValid())
+				return AABB();
+
+			const glm::vec3 center = GetCenter();
+			const glm::vec3 extents = GetExtents();
+			const glm::vec3 newCenter = glm::vec3(matrix[3]) +
+				glm::vec3(matrix[0]) * center.x + glm::vec3(matrix[1]) * center.y + glm::vec3(matrix[2]) * center.z;
+			const glm::vec3 newExtents =
+				glm::abs(glm::vec3(matrix[0])) * extents.x + glm::abs(glm::vec3(matrix[1])) * extents.y + glm::abs(glm::vec3(matrix[2])) * extents.z;
+			return AABB(newCenter - newExtents, newCenter + newExtents);
+		}
+
+		static inline AABB Merge(const AABB& a, const AABB& b)
+		{
+			return AABB(glm::min(a.Min, b.Min), glm::max(a.Max, b.Max));
+		}
+	};
+
+	/**
+	 * @struct BoundingSphere
+	 * @brief A sphere, used for proximity queries.
+	 */
+	struct BoundingSphere
+	{
+		glm::vec3 Center = glm::vec3(0.0f);
+		float Radius = 0.0f;
+
+		inline bool Intersects(const AABB& box) const
+		{
+			const glm::vec3 closest = glm::min(glm::max(Center, box.Min), box.Max);
+			const glm::vec3 offset = closest - Center;
+			return glm::dot(offset, offset) <= Radius * Radius;
+		}
+	};
+
+	/**
+	 * @struct Ray
+	 * @brief A half-line, used for picking.
+	 */
+	struct Ray
+	{
+		glm::vec3 Origin = glm::vec3(0.0f);
+		// Normalized, so distances along the ray are in world units
+		glm::vec3 Direction = glm::vec3(0.0f, 0.0f, -1.0f);
+
+		/**
+		 * @brief Slab test against a box.
+		 *
+		 * @param box The box to test.
+		 * @param inverseDirection 1 / Direction, computed once per ray.
+		 * @param maxDistance Hits further than this are ignored.
+		 * @param distance Receives the distance to the entry point (0 if the origin is inside).
+		 * @return True if the ray hits the box within maxDistance.
+		 */
+		inline bool Intersects(const AABB& box, const glm::vec3& inverseDirection, const float maxDistance, float& distance) const
+		{
+			const glm::vec3 t0 = (box.Min - Origin) * inverseDirection;
+			const glm::vec3 t1 = (box.Max - Origin) * inverseDirection;
+			const glm::vec3 tMin = glm::min(t0, t1);
+			const glm::vec3 tMax = glm::max(t0, t1);
+
+			const float entry = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+			const float exit = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+			distance = entry;
+			return entry <= exit;
+		}
+
+		inline glm::vec3 GetInverseDirection() const
+		{
+			return glm::vec3(1.0f / Direction.x, 1.0f / Direction.y, 1.0f / Direction.z);
+		}
+	};
+
+	/**
+	 * @struct Frustum
+	 * @brief The six planes of a camera's view volume.
+	 */
+	struct Frustum
+	{
+		// Plane normals (xyz) point inwards, w is the plane's distance term
+		std::array<glm::vec4, 6> Planes;
+
+		Frustum() = default;
+
+		/**
+		 * @brief Extracts the planes from a view projection matrix (OpenGL clip space).
+		 */
+		explicit Frustum(const glm::mat4& viewProjection)
+		{
+			const glm::vec4 rowX(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+			const glm::vec4 rowY(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+			const glm::vec4 rowZ(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+			const glm::vec4 rowW(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+			Planes = { rowW + rowX, rowW - rowX, rowW + rowY, rowW - rowY, rowW + rowZ, rowW - rowZ };
+			for (glm::vec4& plane : Planes)
+				plane = plane * (1.0f / glm::length(glm::vec3(plane)));
+		}
+
+		/**
+		 * @brief Checks if a box is at least partly inside the frustum.
+		 *
+		 * @details Conservative: boxes near the frustum's corners can pass without being visible.
+		 */
+		inline bool Intersects(const AABB& box) const
+		{
+			const glm::vec3 center = box.GetCenter();
+			const glm::vec3 extents = box.GetExtents();
+			for (const glm::vec4& plane : Planes)
+			{
+				const glm::vec3 normal(plane);
+				if (glm::dot(normal, center) + plane.w + glm::dot(glm::abs(normal), extents) < 0.0f)
+					return false;
+			}
+			return true;
+		}
+
+		/**
+		 * @brief Checks if a box is completely inside the frustum.
+		 */
+		inline bool Contains(const AABB& box) const
+		{
+			const glm::vec3 center = box.GetCenter();
+			const glm::vec3 extents = box.GetExtents();
+			for (const glm::vec4& plane : Planes)
+			{
+				const glm::vec3 normal(plane);
+				if (glm::dot(normal, center) + plane.w - glm::dot(glm::abs(normal), extents) < 0.0f)
+					return false;
+			}
+			return true;
+		}
+	};
+
+}
\ No newline at end of file
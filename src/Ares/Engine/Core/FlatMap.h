@@ -0,0 +1,274 @@
+/**
+ * @file FlatMap.h
+ * @brief Defines the FlatMap class, an open-addressing hash map for integer keys.
+ *
+ * @details Entries live in a single array probed linearly from the key's home slot, so a lookup
+ * usually touches one cache line instead of chasing a bucket list like `std::unordered_map`.
+ * Keys are expected to be integers (ids or precomputed hashes) and are spread over the table
+ * with a Fibonacci multiply. Erasing shifts the following entries back instead of leaving
+ * tombstones, so probe sequences never grow from churn.
+ */
+#pragma once
+
+namespace Ares {
+
+	/**
+	 * @class FlatMap
+	 * @brief Hash map from integer keys to values stored inline in one probed array.
+	 *
+	 * @details Inserting may grow the table and erasing may shift entries, both move values, so
+	 * pointers & iterators are only valid until the next insertion or erase. Empty slots hold
+	 * default constructed values, erased values are reset to release what they own.
+	 *
+	 * @tparam Key Integer key type.
+	 * @tparam Value Default constructible & movable value type.
+	 *
+	 * **Example usage**:
+	 * ```cpp
+	 * FlatMap<uint32_t, float> depths;
+	 * depths[entityId] = 1.0f;
+	 * if (float* depth = depths.Find(entityId))
+	 *     *depth += 1.0f;
+	 * ```
+	 */
+	template <typename Key, typename Value>
+	class FlatMap
+	{
+		static_assert(std::is_integral_v<Key>, "FlatMap keys must be integers!");
+
+	public:
+		using Entry = std::pair<Key, Value>;
+
+		static constexpr size_t MinCapacity = 16;
+
+		/**
+		 * @brief Forward iterator over the occupied entries, in table order.
+		 */
+		template <bool Const>
+		class Iterator
+		{
+		public:
+			using MapType = std::conditional_t<Const, const FlatMap, FlatMap>;
+			using EntryType = std::conditional_t<Const, const Entry, Entry>;
+
+			Iterator(MapType* map, size_t index)
+				: m_Map(map), m_Index(index)
+			{
+				SkipEmpty();
+			}
+
+			inline EntryType& operator*() const { return m_Map->m_Entries[m_Index]; }
+			inline EntryType* operator->() const { return &m_Map->m_Entries[m_Index]; }
+			inline Iterator& operator++() { m_Index++; SkipEmpty(); return *this; }
+			inline bool operator==(const Iterator& other) const { return m_Index == other.m_Index; }
+			inline bool operator!=(const Iterator& other) const { return m_Index != other.m_Index; }
+
+		private:
+			inline void SkipEmpty()
+			{
+				while (m_Index < m_Map->m_Occupied.size() && !m_Map->m_Occupied[m_Index])
+					m_Index++;
+			}
+
+		private:
+			MapType* m_Map;
+			size_t m_Index;
+		};
+
+	public:
+		FlatMap() = default;
+
+		/**
+		 * @brief Gets the number of entries in the map.
+		 */
+		inline size_t Size() const { return m_Size; }
+
+		/**
+		 * @brief Checks if the map has no entries.
+		 */
+		inline bool Empty() const { return m_Size == 0; }
+
+		/**
+		 * @brief Gets the number of slots in the table.
+		 */
+		inline size_t GetCapacity() const { return m_Occupied.size(); }
+
+		/**
+		 * @brief Finds the value of a key.
+		 *
+		 * @param key The key to look for.
+		 * @return A pointer to the value, or nullptr if the key isn't in the map.
+		 */
+		Value* Find(const Key key)
+		{
+			const size_t index = FindIndex(key);
+			return index != InvalidIndex ? &m_Entries[index].second : nullptr;
+		}
+
+		/**
+		 * @brief Finds the value of a key.
+		 *
+		 * @param key The key to look for.
+		 * @return A pointer to the value, or nullptr if the key isn't in the map.
+		 */
+		const Value* Find(const Key key) const
+		{
+			const size_t index = FindIndex(key);
+			return index != InvalidIndex ? &m_Entries[index].second : nullptr;
+		}
+
+		/**
+		 * @brief Checks if a key is in the map.
+		 */
+		inline bool Contains(const Key key) const { return FindIndex(key) != InvalidIndex; }
+
+		/**
+		 * @brief Inserts a value constructed from the arguments, unless the key is already in the map.
+		 *
+		 * @param key The key to insert.
+		 * @param args Arguments forwarded to the value's constructor.
+		 * @return The entry of the key, and true if it was inserted.
+		 */
+		template <typename... Args>
+		std::pair<Entry*, bool> TryEmplace(const Key key, Args&&... args)
+		{
+			// Grow past 3/4 load, linear probing degrades quickly above that
+			if ((m_Size + 1) * 4 > GetCapacity() * 3)
+				Rehash(std::max(GetCapacity() * 2, MinCapacity));
+
+			size_t index = HomeIndex(key);
+			while (m_Occupied[index])
+			{
+				if (m_Entries[index].first == key)
+					return { &m_Entries[index], false };
+				index = (index + 1) & m_Mask;
+			}
+
+			m_Occupied[index] = 1;
+			m_Entries[index].first = key;
+			m_Entries[index].second = Value(std::forward<Args>(args)...);
+			m_Size++;
+			return { &m_Entries[index], true };
+		}
+
+		/**
+		 * @brief Gets the value of a key, inserting a default constructed one if it isn't in the map.
+		 */
+		inline Value& operator[](const Key key) { return TryEmplace(key).first->second; }
+
+		/**
+		 * @brief Erases a key and its value.
+		 *
+		 * @param key The key to erase.
+		 * @return True if the key was in the map.
+		 */
+		bool Erase(const Key key)
+		{
+			size_t hole = FindIndex(key);
+			if (hole == InvalidIndex)
+				return false;
+
+			// Shift back every following entry of the cluster whose home slot doesn't lie between the hole and it
+			for (size_t index = (hole + 1) & m_Mask; m_Occupied[index]; index = (index + 1) & m_Mask)
+			{
+				const size_t home = HomeIndex(m_Entries[index].first);
+				if (((index - home) & m_Mask) >= ((index - hole) & m_Mask))
+				{
+					m_Entries[hole] = std::move(m_Entries[index]);
+					hole = index;
+				}
+			}
+
+			m_Occupied[hole] = 0;
+			m_Entries[hole].second = Value();
+			m_Size--;
+			return true;
+		}
+
+		/**
+		 * @brief Erases every entry, keeping the table's capacity.
+		 */
+		void Clear()
+		{
+			for (size_t index = 0; index < m_Occupied.size(); index++)
+			{
+				if (m_Occupied[index])
+					m_Entries[index].second = Value();
+			}
+			std::fill(m_Occupied.begin(), m_Occupied.end(), 0);
+			m_Size = 0;
+		}
+
+		/**
+		 * @brief Grows the table so it can hold a number of entries without rehashing.
+		 */
+		void Reserve(const size_t count)
+		{
+			size_t capacity = MinCapacity;
+			while (count * 4 > capacity * 3)
+				capacity *= 2;
+			if (capacity > GetCapacity())
+				Rehash(capacity);
+		}
+
+		inline Iterator<false> begin() { return Iterator<false>(this, 0); }
+		inline Iterator<false> end() { return Iterator<false>(this, m_Occupied.size()); }
+		inline Iterator<true> begin() const { return Iterator<true>(this, 0); }
+		inline Iterator<true> end() const { return Iterator<true>(this, m_Occupied.size()); }
+
+	private:
+		static constexpr size_t InvalidIndex = std::numeric_limits<size_t>::max();
+
+		inline size_t HomeIndex(const Key key) const
+		{
+			// Fibonacci hashing, the high bits of the product are the best mixed
+			return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9e3779b97f4a7c15ull) >> m_Shift);
+		}
+
+		size_t FindIndex(const Key key) const
+		{
+			if (m_Size == 0)
+				return InvalidIndex;
+
+			for (size_t index = HomeIndex(key); m_Occupied[index]; index = (index + 1) & m_Mask)
+			{
+				if (m_Entries[index].first == key)
+					return index;
+			}
+			return InvalidIndex;
+		}
+
+		void Rehash(const size_t capacity)
+		{
+			std::vector<Entry> entries(capacity);
+			std::vector<uint8_t> occupied(capacity, 0);
+			std::swap(entries, m_Entries);
+			std::swap(occupied, m_Occupied);
+
+			m_Mask = capacity - 1;
+			m_Shift = 64;
+			for (size_t size = capacity; size > 1; size >>= 1)
+				m_Shift--;
+
+			for (size_t i = 0; i < occupied.size(); i++)
+			{
+				if (!occupied[i])
+					continue;
+
+				size_t index = HomeIndex(entries[i].first);
+				while (m_Occupied[index])
+					index = (index + 1) & m_Mask;
+				m_Occupied[index] = 1;
+				m_Entries[index] = std::move(entries[i]);
+			}
+		}
+
+	private:
+		std::vector<Entry> m_Entries;
+		std::vector<uint8_t> m_Occupied;
+		size_t m_Size = 0;
+		size_t m_Mask = 0;
+		uint32_t m_Shift = 64;
+	};
+
+}
\ No newline at end of file
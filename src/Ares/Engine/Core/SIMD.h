@@ -0,0 +1,21 @@
+/**
+ * @file SIMD.h
+ * @brief Detects the SIMD instruction sets available at compile time.
+ *
+ * @details Defines AR_SIMD_SSE when SSE2 is available (always the case on x64) and AR_SIMD_AVX
+ * when the compiler targets AVX (e.g. MSVC `/arch:AVX` or `/arch:AVX2`). Code that uses the
+ * intrinsics should provide a scalar fallback for when neither macro is defined.
+ */
+#pragma once
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define AR_SIMD_SSE 1
+#endif
+
+#if defined(__AVX__)
+	#define AR_SIMD_AVX 1
+#endif
+
+#if defined(AR_SIMD_SSE) || defined(AR_SIMD_AVX)
+	#include <immintrin.h>
+#endif
\ No newline at end of file
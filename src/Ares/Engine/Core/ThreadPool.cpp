@@ -75,4 +75,80 @@ namespace Ares {
 			s_TaskQueue.pop();
 	}
 
+	void ThreadPool::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& func)
+	{
+		if (count == 0)
+			return;
+
+		grainSize = std::max<size_t>(grainSize, 1);
+		const size_t sliceCount = (count + grainSize - 1) / grainSize;
+		const size_t helperCount = std::min(sliceCount - 1, GetThreadCount());
+		if (helperCount == 0)
+		{
+			func(0, count);
+			return;
+		}
+
+		// Shared by the helpers, which may outlive this call if they only start once all work is done
+		struct Job
+		{
+			std::function<void(size_t, size_t)> Func;
+			size_t Count;
+			size_t GrainSize;
+			size_t SliceCount;
+			std::atomic<size_t> NextSlice = 0;
+			std::atomic<size_t> CompletedSlices = 0;
+			// First exception thrown by a slice, rethrown on the calling thread
+			std::exception_ptr Exception;
+			std::mutex ExceptionMutex;
+			std::atomic<bool> Failed = false;
+		};
+
+		Ref<Job> job = CreateRef<Job>();
+		job->Func = func;
+		job->Count = count;
+		job->GrainSize = grainSize;
+		job->SliceCount = sliceCount;
+
+		auto work = [](Job& job) {
+			size_t slice;
+			while ((slice = job.NextSlice.fetch_add(1)) < job.SliceCount)
+			{
+				// Slices left after a failure are only counted, a throwing slice still counts as completed
+				if (!job.Failed.load(std::memory_order_relaxed))
+				{
+					try
+					{
+						const size_t begin = slice * job.GrainSize;
+						job.Func(begin, std::min(begin + job.GrainSize, job.Count));
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> lock(job.ExceptionMutex);
+						if (!job.Exception)
+							job.Exception = std::current_exception();
+						job.Failed.store(true, std::memory_order_relaxed);
+					}
+				}
+				job.CompletedSlices.fetch_add(1, std::memory_order_release);
+			}
+		};
+
+		for (size_t i = 0; i < helperCount; i++)
+			SubmitTask([job, work]() { work(*job); });
+
+		work(*job);
+		while (job->CompletedSlices.load(std::memory_order_acquire) < sliceCount)
+			std::this_thread::yield();
+
+		if (job->Exception)
+			std::rethrow_exception(job->Exception);
+	}
+
+	size_t ThreadPool::GetThreadCount()
+	{
+		std::lock_guard<std::mutex> lock(s_InitMutex);
+		return s_IsInitialized ? s_Workers.size() : 0;
+	}
+
 }
\ No newline at end of file
@@ -52,6 +52,28 @@ namespace Ares {
 		template<typename Func, typename... Args>
 		static auto SubmitTask(Func&& func, Args&&... args) -> std::future<decltype(func(args...))>;
 
+		/**
+		 * @brief Splits a range into slices and processes them on the worker threads and the calling thread.
+		 * 
+		 * @details The calling thread takes part in the work and only returns once every slice is done.
+		 * Helper tasks that start after all slices were claimed return immediately, so this is safe to
+		 * call from inside a task running on the pool (it never waits on queued tasks). If a slice
+		 * throws, the remaining slices are skipped and the first exception is rethrown on the calling
+		 * thread once every slice is accounted for.
+		 * 
+		 * @param count The number of elements in the range.
+		 * @param grainSize The number of elements in each slice.
+		 * @param func The callable invoked as func(begin, end) for every slice.
+		 */
+		static void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& func);
+
+		/**
+		 * @brief Gets the number of worker threads.
+		 * 
+		 * @return The number of worker threads (0 if the pool is not initialized).
+		 */
+		static size_t GetThreadCount();
+
 	private:
 		static std::vector<std::thread> s_Workers;				///< Vector of worker threads.
 		static std::queue<std::function<void()>> s_TaskQueue;	///< Queue of tasks to be executed.
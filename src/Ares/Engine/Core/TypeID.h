@@ -0,0 +1,62 @@
+/**
+ * @file TypeID.h
+ * @brief Defines the TypeID class for dense, RTTI-free type identifiers.
+ *
+ * @details Every type gets a small integer id, unique within a type family (e.g. components or
+ * systems). Ids are handed out from 0 upwards on first use, so they can index plain arrays.
+ * The ids live in function-local statics of inline templates, which the linker merges into a
+ * single instance, so they are consistent across the static libraries linked into one
+ * executable (Ares -> Sandbox).
+ */
+#pragma once
+
+namespace Ares {
+
+	/**
+	 * @class TypeID
+	 * @brief Hands out dense ids for the types of one family.
+	 *
+	 * @tparam Family Tag type naming the family (e.g. `ECS::Component` or `ECS::System`).
+	 *
+	 * **Example usage**:
+	 * ```cpp
+	 * const uint32_t id = TypeID<ECS::Component>::Get<Components::Transform>();
+	 * ```
+	 */
+	template <typename Family>
+	class TypeID
+	{
+	public:
+		/**
+		 * @brief Gets the id of a type, cv-qualifiers and references are ignored.
+		 *
+		 * @tparam T The type to identify.
+		 * @return The id of the type within the family.
+		 */
+		template <typename T>
+		static uint32_t Get()
+		{
+			return Assign<std::remove_cvref_t<T>>();
+		}
+
+		/**
+		 * @brief Gets the number of ids handed out so far.
+		 */
+		static uint32_t Count()
+		{
+			return s_Count.load(std::memory_order_relaxed);
+		}
+
+	private:
+		template <typename T>
+		static uint32_t Assign()
+		{
+			static const uint32_t s_Id = s_Count.fetch_add(1, std::memory_order_relaxed);
+			return s_Id;
+		}
+
+	private:
+		inline static std::atomic<uint32_t> s_Count{ 0 };
+	};
+
+}
\ No newline at end of file
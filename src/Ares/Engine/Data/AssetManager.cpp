@@ -7,6 +7,7 @@
 #include "Engine/Data/DataBuffer.h"
 #include "Engine/Data/FileIO.h"
 #include "Engine/Data/MemoryDataProvider.h"
+#include "Engine/Data/MeshSimplifier.h"
 #include "Engine/Data/RawData.h"
 #include "Engine/Data/Parsers/OBJParser.h"
 #include "Engine/Data/Parsers/ShaderParser.h"
@@ -128,6 +129,24 @@ namespace Ares {
 		return asset;
 	}
 
+	std::vector<Ref<Asset>> AssetManager::StageMeshLODs(const Ref<Asset>& meshAsset, const std::vector<float>& targetRatios)
+	{
+		AR_CORE_ASSERT(meshAsset && meshAsset->GetType() == typeid(MeshData), "Mesh LODs can only be generated from MeshData assets!");
+
+		std::vector<Ref<Asset>> levels;
+		levels.reserve(targetRatios.size());
+		for (size_t i = 0; i < targetRatios.size(); i++)
+		{
+			const float targetRatio = targetRatios[i];
+			AR_CORE_ASSERT(targetRatio > 0.0f && targetRatio <= 1.0f, "Mesh LOD target ratio must be in (0, 1]!");
+
+			// The ratio is kept in memory data, which also gives every level its own content hash
+			const MemoryDataKey ratioKey = MemoryDataProvider::RegisterData(&targetRatio, sizeof(targetRatio));
+			levels.push_back(Stage<MeshData>(meshAsset->GetName() + "_LOD" + std::to_string(i + 1), "", { meshAsset }, ratioKey));
+		}
+		return levels;
+	}
+
 	void AssetManager::Unstage(const Ref<Asset>& asset)
 	{
 		// Check for references outside AssetManager
@@ -202,8 +221,14 @@ namespace Ares {
 							LoadRawAsset(currentDep, [assets, callback](Ares::Ref<Asset> asset) mutable { Load(assets, std::move(callback)); });
 							return;
 						}
+						// Wait for a dependency another load already started, the assets are loaded again once it resolves
+						else if (currentDep->GetState() == AssetState::Loading)
+						{
+							if (WaitForAsset(currentDep, [assets, callback]() mutable { Load(assets, std::move(callback)); }))
+								return;
+						}
 						// Log if dependency failed
-						else if (currentDep->GetState() == AssetState::Failed)
+						if (currentDep->GetState() == AssetState::Failed)
 						{
 							AR_CORE_ASSERT(false, "Asset: {} failed to load!", currentDep->GetName());
 						}
@@ -365,6 +390,38 @@ namespace Ares {
 			for (auto& globalListener : s_GlobalListeners)
 				QueueListenerCallback([func = globalListener.second, event]() { func(*event); });
 		}
+
+		if constexpr (std::is_same_v<AssetEventType, AssetLoadedEvent> || std::is_same_v<AssetEventType, AssetFailedEvent>)
+			ResumePendingLoads(asset);
+	}
+
+	bool AssetManager::WaitForAsset(const Ref<Asset>& asset, std::function<void()> resume)
+	{
+		// Checked under the lock, so the asset can't resolve between the check and queueing the load
+		std::lock_guard<std::mutex> lock(s_PendingLoadsMutex);
+		if (asset->GetState() != AssetState::Loading)
+			return false;
+
+		s_PendingLoads[asset->GetAssetId()].push_back(std::move(resume));
+		return true;
+	}
+
+	void AssetManager::ResumePendingLoads(const Ref<Asset>& asset)
+	{
+		std::vector<std::function<void()>> pendingLoads;
+		{
+			std::lock_guard<std::mutex> lock(s_PendingLoadsMutex);
+			auto it = s_PendingLoads.find(asset->GetAssetId());
+			if (it == s_PendingLoads.end())
+				return;
+
+			pendingLoads = std::move(it->second);
+			s_PendingLoads.erase(it);
+		}
+
+		// Resumed from OnUpdate like any other chained load
+		for (std::function<void()>& resume : pendingLoads)
+			QueueCallback(std::move(resume));
 	}
 
 	void AssetManager::QueueListenerCallback(std::function<void()> callback)
@@ -570,7 +627,27 @@ namespace Ares {
 					const DataBuffer& data = MemoryDataProvider::GetData(asset->GetDataKey());
 					Ref<ParsedMeshData> meshData = nullptr;
 
-					if (Utility::GetFileExtension(asset->GetFilepath()) == "obj")
+					if (asset->GetDependencies().size() > 0)
+					{
+						// Generated level of detail, simplified from the source mesh
+						Ref<Asset> source = AssetManager::GetAsset(asset->GetDependencies()[0]);
+						if (source == nullptr || source->GetState() != AssetState::Loaded)
+							throw std::runtime_error("Mesh LOD source is not loaded!");
+						if (data.GetSize() != sizeof(float))
+							throw std::runtime_error("Mesh LOD doesn't have a valid target ratio!");
+
+						float targetRatio = 0.0f;
+						std::memcpy(&targetRatio, data.GetBuffer(), sizeof(targetRatio));
+						if (!(targetRatio > 0.0f && targetRatio <= 1.0f))
+							throw std::runtime_error("Mesh LOD target ratio must be in (0, 1]!");
+
+						ParsedMeshData sourceData = OBJParser::ParseMesh(MemoryDataProvider::GetData(source->GetDataKey()));
+						if (!sourceData.IsValid)
+							throw std::runtime_error("Error while parsing Mesh LOD source: " + sourceData.Error);
+
+						meshData = CreateRef<ParsedMeshData>(MeshSimplifier::Simplify(sourceData, targetRatio));
+					}
+					else if (Utility::GetFileExtension(asset->GetFilepath()) == "obj")
 					{
 						meshData = CreateRef<ParsedMeshData>(OBJParser::ParseMesh(data));
 					}
@@ -725,6 +802,9 @@ namespace Ares {
 	std::queue<std::function<void()>> AssetManager::s_CallbackQueue;
 	std::mutex AssetManager::s_CallbackQueueMutex;
 
+	std::unordered_map<uint32_t, std::vector<std::function<void()>>> AssetManager::s_PendingLoads;
+	std::mutex AssetManager::s_PendingLoadsMutex;
+
 	std::atomic<uint32_t> AssetManager::s_NextListenerId{ 1 };
 	std::unordered_map<std::string, std::unordered_map<uint32_t, AssetManager::AssetListenerCallbackFn>> AssetManager::s_Listeners;
 	std::unordered_map<uint32_t, std::string> AssetManager::s_ListenerNameMap;
@@ -110,6 +110,20 @@ namespace Ares {
 		 */
 		template <typename AssetType>
 		inline static Ref<Asset> Stage(const std::string& name, const MemoryDataKey dataKey) { return Stage<AssetType>(name, "", {}, dataKey); }
+
+		/**
+		 * @brief Stages generated levels of detail for a MeshData asset.
+		 * 
+		 * @details Each level is a MeshData asset depending on the source mesh. When loaded, the
+		 * source mesh data is parsed again and simplified with the MeshSimplifier on a ThreadPool
+		 * worker, so levels load in parallel. The levels can be put in a MeshLODChain with their
+		 * screen sizes once staged.
+		 * 
+		 * @param meshAsset The staged MeshData asset to generate levels of detail for.
+		 * @param targetRatios Fraction of the source triangles to keep for each level, in (0, 1].
+		 * @return A Ref to the staged Asset of each level, in the same order as the ratios.
+		 */
+		static std::vector<Ref<Asset>> StageMeshLODs(const Ref<Asset>& meshAsset, const std::vector<float>& targetRatios);
 		
 		/**
 		 * @brief Removes an asset completely from the AssetManager.
@@ -207,6 +221,10 @@ namespace Ares {
 		// Private loaders
 		static void LoadRawAsset(const Ref<Asset>& asset, AssetCallbackFn&& callback);
 
+		// Loads waiting on a dependency that is still loading, resumed once it's loaded or failed
+		static bool WaitForAsset(const Ref<Asset>& asset, std::function<void()> resume);
+		static void ResumePendingLoads(const Ref<Asset>& asset);
+
 		// Private hash function
 		static const size_t GetHash(const std::type_index& type, const std::string& filepath, const std::vector<uint32_t>& dependencies, const MemoryDataKey dataKey);
 		static Ref<Asset> FindExistingAsset(const size_t& contentHash);
@@ -229,6 +247,10 @@ namespace Ares {
 		static std::queue<std::function<void()>> s_CallbackQueue;
 		static std::mutex s_CallbackQueueMutex;
 
+		// Pending loads by the id of the dependency they wait on
+		static std::unordered_map<uint32_t, std::vector<std::function<void()>>> s_PendingLoads;
+		static std::mutex s_PendingLoadsMutex;
+
 		static std::atomic<uint32_t> s_NextListenerId;
 		static std::unordered_map<std::string, std::unordered_map<uint32_t, AssetListenerCallbackFn>> s_Listeners;
 		static std::unordered_map<uint32_t, std::string> s_ListenerNameMap;
@@ -38,7 +38,7 @@ namespace Ares {
 
 	bool FileIO::SaveFile(const std::string& filepath, const DataBuffer& buffer)
 	{
-		std::ofstream file(filepath, std::ios::binary | std::ios::in);
+		std::ofstream file(filepath, std::ios::binary | std::ios::out | std::ios::trunc);
 		if (!file)
 		{
 			AR_CORE_WARN("Failed to open file for writing: '{}'", filepath);
@@ -0,0 +1,131 @@
+#include <arespch.h>
+#include "Engine/Data/MappedFile.h"
+
+namespace Ares {
+
+#ifdef AR_PLATFORM_WINDOWS
+	namespace {
+
+		// Paths are UTF-8, widening them byte by byte would mangle anything outside ASCII.
+		// Returns an empty string for invalid UTF-8, which CreateFileW then fails to open.
+		std::wstring ToWidePath(const std::string& filepath)
+		{
+			const int length = static_cast<int>(filepath.size());
+			const int wideLength = MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, filepath.data(), length, nullptr, 0);
+			if (wideLength <= 0)
+				return {};
+
+			std::wstring widePath(static_cast<size_t>(wideLength), L'\0');
+			MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, filepath.data(), length, widePath.data(), wideLength);
+			return widePath;
+		}
+
+	}
+#endif
+
+	MappedFile::MappedFile(const std::string& filepath)
+	{
+	#ifdef AR_PLATFORM_WINDOWS
+		HANDLE file = CreateFileW(
+			ToWidePath(filepath).c_str(),
+			GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+		);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			AR_CORE_WARN("Failed to open file for mapping: '{}'", filepath);
+			return;
+		}
+		m_FileHandle = file;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			AR_CORE_WARN("Failed to map empty file: '{}'", filepath);
+			Close();
+			return;
+		}
+
+		m_MappingHandle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_MappingHandle == nullptr)
+		{
+			AR_CORE_WARN("Failed to create file mapping: '{}'", filepath);
+			Close();
+			return;
+		}
+
+		m_Data = static_cast<const uint8_t*>(MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0));
+		if (m_Data == nullptr)
+		{
+			AR_CORE_WARN("Failed to map view of file: '{}'", filepath);
+			Close();
+			return;
+		}
+		m_Size = static_cast<size_t>(fileSize.QuadPart);
+	#else
+		std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			AR_CORE_WARN("Failed to open file for mapping: '{}'", filepath);
+			return;
+		}
+
+		m_Buffer.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0, std::ios::beg);
+		if (m_Buffer.empty() || !file.read(reinterpret_cast<char*>(m_Buffer.data()), m_Buffer.size()))
+		{
+			AR_CORE_WARN("Failed to read from file: '{}'", filepath);
+			m_Buffer.clear();
+			return;
+		}
+		m_Data = m_Buffer.data();
+		m_Size = m_Buffer.size();
+	#endif
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			m_Data = std::exchange(other.m_Data, nullptr);
+			m_Size = std::exchange(other.m_Size, 0);
+		#ifdef AR_PLATFORM_WINDOWS
+			m_FileHandle = std::exchange(other.m_FileHandle, nullptr);
+			m_MappingHandle = std::exchange(other.m_MappingHandle, nullptr);
+		#else
+			m_Buffer = std::move(other.m_Buffer);
+		#endif
+		}
+		return *this;
+	}
+
+	void MappedFile::Close()
+	{
+	#ifdef AR_PLATFORM_WINDOWS
+		if (m_Data != nullptr)
+			UnmapViewOfFile(m_Data);
+		if (m_MappingHandle != nullptr)
+			CloseHandle(m_MappingHandle);
+		if (m_FileHandle != nullptr)
+			CloseHandle(m_FileHandle);
+		m_FileHandle = nullptr;
+		m_MappingHandle = nullptr;
+	#else
+		m_Buffer.clear();
+	#endif
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+
+}
\ No newline at end of file
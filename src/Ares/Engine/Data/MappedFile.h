@@ -0,0 +1,66 @@
+/**
+ * @file MappedFile.h
+ * @brief Defines the MappedFile class for read-only memory-mapped file access.
+ *
+ * @details Mapping a file lets the OS page its contents in on demand instead of copying the
+ * whole file through a read buffer, which makes it well suited to large binary files that are
+ * consumed in place (e.g. scene snapshots).
+ */
+#pragma once
+
+namespace Ares {
+
+	/**
+	 * @class MappedFile
+	 * @brief A read-only view of a file's contents, mapped into memory.
+	 *
+	 * @details The mapping stays valid for the lifetime of the object. On platforms without
+	 * a mapping implementation the file is read into memory instead.
+	 */
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+
+		/**
+		 * @brief Maps a file, check the result with `operator bool`.
+		 *
+		 * @param filepath The path of the file to map.
+		 */
+		explicit MappedFile(const std::string& filepath);
+
+		~MappedFile();
+
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/**
+		 * @brief Gets a pointer to the start of the mapped file.
+		 */
+		inline const uint8_t* GetData() const { return m_Data; }
+
+		/**
+		 * @brief Gets the size of the mapped file in bytes.
+		 */
+		inline size_t GetSize() const { return m_Size; }
+
+		inline explicit operator bool() const { return m_Data != nullptr && m_Size > 0; }
+
+	private:
+		void Close();
+
+	private:
+		const uint8_t* m_Data = nullptr;	///< Start of the mapped view.
+		size_t m_Size = 0;					///< Size of the file in bytes.
+	#ifdef AR_PLATFORM_WINDOWS
+		void* m_FileHandle = nullptr;		///< Handle of the open file.
+		void* m_MappingHandle = nullptr;	///< Handle of the file mapping object.
+	#else
+		std::vector<uint8_t> m_Buffer;		///< File contents when mapping isn't available.
+	#endif
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,513 @@
+#include <arespch.h>
+#include "Engine/Data/MeshSimplifier.h"
+
+#include <glm/geometric.hpp>
+
+#include "Engine/Core/ThreadPool.h"
+#include "Engine/Data/Parsers/OBJParser.h"
+
+namespace Ares {
+
+	namespace {
+
+		// Weight of the planes keeping borders & seams in place, relative to the triangle planes
+		constexpr double ConstraintWeight = 10.0;
+		// Fraction of the (sorted) candidate edges considered in one pass before costs are recomputed
+		constexpr size_t PassFraction = 3;
+		// Cosine of the largest rotation a collapse may apply to a triangle normal
+		constexpr double MinNormalCosine = 0.25;
+		constexpr uint32_t Invalid = std::numeric_limits<uint32_t>::max();
+
+		// Symmetric 4x4 matrix measuring the summed squared distance to a set of planes
+		struct Quadric
+		{
+			// a00 a01 a02 a03 a11 a12 a13 a22 a23 a33
+			double A[10] = {};
+
+			static Quadric FromPlane(const glm::dvec3& normal, const double distance, const double weight)
+			{
+				Quadric quadric;
+				quadric.A[0] = weight * normal.x * normal.x;
+				quadric.A[1] = weight * normal.x * normal.y;
+				quadric.A[2] = weight * normal.x * normal.z;
+				quadric.A[3] = weight * normal.x * distance;
+				quadric.A[4] = weight * normal.y * normal.y;
+				quadric.A[5] = weight * normal.y * normal.z;
+				quadric.A[6] = weight * normal.y * distance;
+				quadric.A[7] = weight * normal.z * normal.z;
+				quadric.A[8] = weight * normal.z * distance;
+				quadric.A[9] = weight * distance * distance;
+				return quadric;
+			}
+
+			Quadric& operator+=(const Quadric& other)
+			{
+				for (size_t i = 0; i < 10; i++)
+					A[i] += other.A[i];
+				return *this;
+			}
+
+			double Evaluate(const glm::dvec3& p) const
+			{
+				return A[0] * p.x * p.x + 2.0 * A[1] * p.x * p.y + 2.0 * A[2] * p.x * p.z + 2.0 * A[3] * p.x +
+					A[4] * p.y * p.y + 2.0 * A[5] * p.y * p.z + 2.0 * A[6] * p.y +
+					A[7] * p.z * p.z + 2.0 * A[8] * p.z + A[9];
+			}
+		};
+
+		// Welds vertices with identical attributes
+		template <size_t Size>
+		struct AttributeKeyHash
+		{
+			size_t operator()(const std::array<float, Size>& key) const
+			{
+				size_t hash = 14695981039346656037ull;
+				for (const float value : key)
+				{
+					// -0 and 0 compare equal, so they must hash the same
+					const float normalized = value == 0.0f ? 0.0f : value;
+					uint32_t bits;
+					std::memcpy(&bits, &normalized, sizeof(bits));
+					hash = (hash ^ bits) * 1099511628211ull;
+				}
+				return hash;
+			}
+		};
+
+		inline uint64_t EdgeKey(const uint32_t a, const uint32_t b)
+		{
+			return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+		}
+
+		class Simplifier
+		{
+		public:
+			Simplifier(const ParsedMeshData& mesh)
+				: m_Mesh(mesh)
+			{
+				const size_t vertexCount = mesh.Positions.size() / 3;
+				m_HasTextureCoordinates = mesh.TextureCoordinates.size() == vertexCount * 2;
+				m_HasNormals = mesh.Normals.size() == vertexCount * 3;
+
+				Weld(vertexCount);
+				BuildQuadrics();
+			}
+
+			inline size_t GetTriangleCount() const { return m_LiveTriangles; }
+
+			void Simplify(const size_t targetTriangles)
+			{
+				struct Candidate
+				{
+					double Cost;
+					uint32_t From;
+					uint32_t To;
+				};
+				std::vector<Candidate> candidates;
+				std::vector<uint64_t> edges;
+				std::vector<uint8_t> locked(m_PositionCount);
+
+				while (m_LiveTriangles > targetTriangles)
+				{
+					// Every unique edge, in its cheaper direction first
+					edges.clear();
+					for (size_t t = 0; t < m_Triangles.size(); t++)
+					{
+						if (!m_TriangleAlive[t])
+							continue;
+						const uint32_t p0 = m_WedgePosition[m_Triangles[t][0]];
+						const uint32_t p1 = m_WedgePosition[m_Triangles[t][1]];
+						const uint32_t p2 = m_WedgePosition[m_Triangles[t][2]];
+						edges.push_back(EdgeKey(p0, p1));
+						edges.push_back(EdgeKey(p1, p2));
+						edges.push_back(EdgeKey(p2, p0));
+					}
+					std::sort(edges.begin(), edges.end());
+					edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+					candidates.clear();
+					for (const uint64_t edge : edges)
+					{
+						const uint32_t a = static_cast<uint32_t>(edge >> 32);
+						const uint32_t b = static_cast<uint32_t>(edge & 0xffffffffu);
+						Quadric quadric = m_Quadrics[a];
+						quadric += m_Quadrics[b];
+						const double costToB = quadric.Evaluate(m_Positions[b]);
+						const double costToA = quadric.Evaluate(m_Positions[a]);
+						candidates.push_back(costToB <= costToA ? Candidate{ costToB, a, b } : Candidate{ costToA, b, a });
+					}
+					std::sort(candidates.begin(), candidates.end(), [](const Candidate& l, const Candidate& r) { return l.Cost < r.Cost; });
+
+					// Collapses in one pass can't share vertices, so their costs stay accurate
+					std::fill(locked.begin(), locked.end(), 0);
+					const size_t passCount = std::max<size_t>(candidates.size() / PassFraction, 1);
+					size_t collapsed = 0;
+					for (size_t i = 0; i < passCount && m_LiveTriangles > targetTriangles; i++)
+					{
+						const Candidate& candidate = candidates[i];
+						if (locked[candidate.From] || locked[candidate.To])
+							continue;
+
+						if (!Collapse(candidate.From, candidate.To, locked) && !Collapse(candidate.To, candidate.From, locked))
+							continue;
+						collapsed++;
+					}
+
+					if (collapsed == 0)
+						break;
+				}
+			}
+
+			ParsedMeshData GetResult() const
+			{
+				ParsedMeshData result;
+				std::vector<uint32_t> remap(m_WedgeSource.size(), Invalid);
+				for (size_t t = 0; t < m_Triangles.size(); t++)
+				{
+					if (!m_TriangleAlive[t])
+						continue;
+
+					for (const uint32_t wedge : m_Triangles[t])
+					{
+						if (remap[wedge] == Invalid)
+						{
+							remap[wedge] = static_cast<uint32_t>(result.Positions.size() / 3);
+							const uint32_t source = m_WedgeSource[wedge];
+							result.Positions.insert(result.Positions.end(), m_Mesh.Positions.begin() + source * 3, m_Mesh.Positions.begin() + source * 3 + 3);
+							if (m_HasTextureCoordinates)
+								result.TextureCoordinates.insert(result.TextureCoordinates.end(), m_Mesh.TextureCoordinates.begin() + source * 2, m_Mesh.TextureCoordinates.begin() + source * 2 + 2);
+							if (m_HasNormals)
+								result.Normals.insert(result.Normals.end(), m_Mesh.Normals.begin() + source * 3, m_Mesh.Normals.begin() + source * 3 + 3);
+						}
+						result.Indices.push_back(remap[wedge]);
+					}
+				}
+
+				result.IsValid = true;
+				result.Error.clear();
+				return result;
+			}
+
+		private:
+			void Weld(const size_t vertexCount)
+			{
+				std::unordered_map<std::array<float, 8>, uint32_t, AttributeKeyHash<8>> wedges;
+				std::unordered_map<std::array<float, 3>, uint32_t, AttributeKeyHash<3>> positions;
+				std::vector<uint32_t> vertexWedge(vertexCount);
+
+				for (size_t v = 0; v < vertexCount; v++)
+				{
+					const std::array<float, 3> position = { m_Mesh.Positions[v * 3], m_Mesh.Positions[v * 3 + 1], m_Mesh.Positions[v * 3 + 2] };
+					std::array<float, 8> attributes = { position[0], position[1], position[2] };
+					if (m_HasTextureCoordinates)
+					{
+						attributes[3] = m_Mesh.TextureCoordinates[v * 2];
+						attributes[4] = m_Mesh.TextureCoordinates[v * 2 + 1];
+					}
+					if (m_HasNormals)
+					{
+						attributes[5] = m_Mesh.Normals[v * 3];
+						attributes[6] = m_Mesh.Normals[v * 3 + 1];
+						attributes[7] = m_Mesh.Normals[v * 3 + 2];
+					}
+
+					auto [wedge, newWedge] = wedges.try_emplace(attributes, static_cast<uint32_t>(m_WedgeSource.size()));
+					if (newWedge)
+					{
+						auto [positionId, newPosition] = positions.try_emplace(position, static_cast<uint32_t>(m_Positions.size()));
+						if (newPosition)
+							m_Positions.emplace_back(position[0], position[1], position[2]);
+						m_WedgeSource.push_back(static_cast<uint32_t>(v));
+						m_WedgePosition.push_back(positionId->second);
+					}
+					vertexWedge[v] = wedge->second;
+				}
+				m_PositionCount = m_Positions.size();
+
+				m_PositionTriangles.resize(m_PositionCount);
+				for (size_t i = 0; i + 2 < m_Mesh.Indices.size(); i += 3)
+				{
+					if (m_Mesh.Indices[i] >= vertexCount || m_Mesh.Indices[i + 1] >= vertexCount || m_Mesh.Indices[i + 2] >= vertexCount)
+						continue;
+
+					const std::array<uint32_t, 3> triangle = { vertexWedge[m_Mesh.Indices[i]], vertexWedge[m_Mesh.Indices[i + 1]], vertexWedge[m_Mesh.Indices[i + 2]] };
+					const uint32_t p0 = m_WedgePosition[triangle[0]], p1 = m_WedgePosition[triangle[1]], p2 = m_WedgePosition[triangle[2]];
+					if (p0 == p1 || p1 == p2 || p2 == p0)
+						continue;
+
+					const uint32_t index = static_cast<uint32_t>(m_Triangles.size());
+					m_Triangles.push_back(triangle);
+					m_PositionTriangles[p0].push_back(index);
+					m_PositionTriangles[p1].push_back(index);
+					m_PositionTriangles[p2].push_back(index);
+				}
+				m_TriangleAlive.assign(m_Triangles.size(), 1);
+				m_LiveTriangles = m_Triangles.size();
+				m_PositionBorder.assign(m_PositionCount, 0);
+			}
+
+			void BuildQuadrics()
+			{
+				m_Quadrics.assign(m_PositionCount, Quadric());
+
+				struct EdgeUse
+				{
+					uint32_t Count = 0;
+					// Wedges at the lower & higher position of the first triangle using the edge
+					uint32_t Low = Invalid, High = Invalid;
+					bool Seam = false;
+					uint32_t Triangle = 0;
+				};
+				std::unordered_map<uint64_t, EdgeUse> edgeUses;
+
+				for (size_t t = 0; t < m_Triangles.size(); t++)
+				{
+					const std::array<uint32_t, 3>& triangle = m_Triangles[t];
+					const glm::dvec3& p0 = m_Positions[m_WedgePosition[triangle[0]]];
+					const glm::dvec3& p1 = m_Positions[m_WedgePosition[triangle[1]]];
+					const glm::dvec3& p2 = m_Positions[m_WedgePosition[triangle[2]]];
+					const glm::dvec3 cross = glm::cross(p1 - p0, p2 - p0);
+					const double length = glm::length(cross);
+					if (length > 0.0)
+					{
+						// Area weighted plane
+						const glm::dvec3 normal = cross / length;
+						const Quadric quadric = Quadric::FromPlane(normal, -glm::dot(normal, p0), length * 0.5);
+						for (const uint32_t wedge : triangle)
+							m_Quadrics[m_WedgePosition[wedge]] += quadric;
+					}
+
+					for (size_t e = 0; e < 3; e++)
+					{
+						uint32_t low = triangle[e], high = triangle[(e + 1) % 3];
+						if (m_WedgePosition[low] > m_WedgePosition[high])
+							std::swap(low, high);
+
+						EdgeUse& use = edgeUses[EdgeKey(m_WedgePosition[low], m_WedgePosition[high])];
+						if (use.Count == 0)
+						{
+							use.Low = low;
+							use.High = high;
+							use.Triangle = static_cast<uint32_t>(t);
+						}
+						else if (use.Low != low || use.High != high)
+						{
+							use.Seam = true;
+						}
+						use.Count++;
+					}
+				}
+
+				// Planes through border & seam edges, perpendicular to their triangle, hold them in place
+				for (const auto& [key, use] : edgeUses)
+				{
+					const bool border = use.Count == 1;
+					if (!border && !use.Seam)
+						continue;
+
+					const uint32_t a = static_cast<uint32_t>(key >> 32), b = static_cast<uint32_t>(key & 0xffffffffu);
+					if (border)
+					{
+						m_PositionBorder[a] = 1;
+						m_PositionBorder[b] = 1;
+					}
+
+					const std::array<uint32_t, 3>& triangle = m_Triangles[use.Triangle];
+					const glm::dvec3& p0 = m_Positions[m_WedgePosition[triangle[0]]];
+					const glm::dvec3 faceNormal = glm::cross(m_Positions[m_WedgePosition[triangle[1]]] - p0, m_Positions[m_WedgePosition[triangle[2]]] - p0);
+					const glm::dvec3 edge = m_Positions[b] - m_Positions[a];
+					const glm::dvec3 normal = glm::cross(edge, faceNormal);
+					const double length = glm::length(normal);
+					if (length <= 0.0)
+						continue;
+
+					const glm::dvec3 planeNormal = normal / length;
+					const Quadric quadric = Quadric::FromPlane(planeNormal, -glm::dot(planeNormal, m_Positions[a]), ConstraintWeight * glm::dot(edge, edge));
+					m_Quadrics[a] += quadric;
+					m_Quadrics[b] += quadric;
+				}
+			}
+
+			// Moves position `from` onto position `to`, returns false if that would break the mesh
+			bool Collapse(const uint32_t from, const uint32_t to, std::vector<uint8_t>& locked)
+			{
+				// Wedges of `from` are replaced by the wedge `to` has in the same triangle along the edge
+				std::vector<std::pair<uint32_t, uint32_t>>& wedgeMap = m_WedgeMap;
+				wedgeMap.clear();
+				size_t sharedTriangles = 0;
+				for (const uint32_t t : m_PositionTriangles[from])
+				{
+					if (!m_TriangleAlive[t])
+						continue;
+
+					uint32_t fromWedge = Invalid, toWedge = Invalid;
+					for (const uint32_t wedge : m_Triangles[t])
+					{
+						if (m_WedgePosition[wedge] == from)
+							fromWedge = wedge;
+						else if (m_WedgePosition[wedge] == to)
+							toWedge = wedge;
+					}
+					if (toWedge == Invalid)
+						continue;
+
+					sharedTriangles++;
+					auto it = std::find_if(wedgeMap.begin(), wedgeMap.end(), [fromWedge](const auto& entry) { return entry.first == fromWedge; });
+					if (it == wedgeMap.end())
+						wedgeMap.emplace_back(fromWedge, toWedge);
+					else if (it->second != toWedge)
+						return false; // The edge is a seam on one end only
+				}
+
+				// Border vertices may only slide along their border
+				if (sharedTriangles == 0 || (m_PositionBorder[from] && sharedTriangles != 1))
+					return false;
+
+				// Link condition: the ends may only share the neighbours opposite the edge, or the collapse makes the mesh non-manifold
+				m_Neighbours.clear();
+				for (const uint32_t t : m_PositionTriangles[to])
+				{
+					if (!m_TriangleAlive[t])
+						continue;
+					for (const uint32_t wedge : m_Triangles[t])
+						m_Neighbours.push_back(m_WedgePosition[wedge]);
+				}
+				std::sort(m_Neighbours.begin(), m_Neighbours.end());
+				m_CommonNeighbours.clear();
+				for (const uint32_t t : m_PositionTriangles[from])
+				{
+					if (!m_TriangleAlive[t])
+						continue;
+					for (const uint32_t wedge : m_Triangles[t])
+					{
+						const uint32_t position = m_WedgePosition[wedge];
+						if (position != from && position != to && std::binary_search(m_Neighbours.begin(), m_Neighbours.end(), position))
+							m_CommonNeighbours.push_back(position);
+					}
+				}
+				// Each neighbour shows up in up to two of from's triangles, count it once
+				std::sort(m_CommonNeighbours.begin(), m_CommonNeighbours.end());
+				const size_t commonNeighbours = std::unique(m_CommonNeighbours.begin(), m_CommonNeighbours.end()) - m_CommonNeighbours.begin();
+				if (commonNeighbours > sharedTriangles)
+					return false;
+
+				// Every other triangle needs a mapped wedge, and must not flip or degenerate
+				const glm::dvec3& target = m_Positions[to];
+				for (const uint32_t t : m_PositionTriangles[from])
+				{
+					if (!m_TriangleAlive[t])
+						continue;
+
+					const std::array<uint32_t, 3>& triangle = m_Triangles[t];
+					bool shared = false;
+					size_t corner = 0;
+					for (size_t c = 0; c < 3; c++)
+					{
+						if (m_WedgePosition[triangle[c]] == to)
+							shared = true;
+						if (m_WedgePosition[triangle[c]] == from)
+							corner = c;
+					}
+					if (shared)
+						continue;
+
+					if (std::none_of(wedgeMap.begin(), wedgeMap.end(), [&](const auto& entry) { return entry.first == triangle[corner]; }))
+						return false; // Crosses an attribute seam
+
+					const glm::dvec3& a = m_Positions[m_WedgePosition[triangle[(corner + 1) % 3]]];
+					const glm::dvec3& b = m_Positions[m_WedgePosition[triangle[(corner + 2) % 3]]];
+					const glm::dvec3 before = glm::cross(a - m_Positions[from], b - m_Positions[from]);
+					const glm::dvec3 after = glm::cross(a - target, b - target);
+					// Rejects folds & slivers: the normal may turn by at most ~75 degrees
+					const double beforeLength = glm::length(before), afterLength = glm::length(after);
+					if (afterLength <= 1e-6 * beforeLength || glm::dot(before, after) <= MinNormalCosine * beforeLength * afterLength)
+						return false;
+				}
+
+				// Apply
+				for (const uint32_t t : m_PositionTriangles[from])
+				{
+					if (!m_TriangleAlive[t])
+						continue;
+
+					std::array<uint32_t, 3>& triangle = m_Triangles[t];
+					bool shared = false;
+					for (const uint32_t wedge : triangle)
+						shared = shared || m_WedgePosition[wedge] == to;
+					if (shared)
+					{
+						m_TriangleAlive[t] = 0;
+						m_LiveTriangles--;
+						continue;
+					}
+
+					for (uint32_t& wedge : triangle)
+					{
+						if (m_WedgePosition[wedge] != from)
+							continue;
+						wedge = std::find_if(wedgeMap.begin(), wedgeMap.end(), [&](const auto& entry) { return entry.first == wedge; })->second;
+					}
+					m_PositionTriangles[to].push_back(t);
+
+					for (const uint32_t wedge : triangle)
+						locked[m_WedgePosition[wedge]] = 1;
+				}
+
+				m_Quadrics[to] += m_Quadrics[from];
+				m_PositionTriangles[from].clear();
+				locked[from] = 1;
+				locked[to] = 1;
+
+				// Drop dead triangles so adjacency lists stay short
+				std::erase_if(m_PositionTriangles[to], [this](const uint32_t t) { return !m_TriangleAlive[t]; });
+				return true;
+			}
+
+		private:
+			const ParsedMeshData& m_Mesh;
+			bool m_HasTextureCoordinates = false;
+			bool m_HasNormals = false;
+
+			// Welded vertices: the source vertex providing their attributes & their position id
+			std::vector<uint32_t> m_WedgeSource;
+			std::vector<uint32_t> m_WedgePosition;
+
+			size_t m_PositionCount = 0;
+			std::vector<glm::dvec3> m_Positions;
+			std::vector<Quadric> m_Quadrics;
+			std::vector<std::vector<uint32_t>> m_PositionTriangles;
+			std::vector<uint8_t> m_PositionBorder;
+
+			std::vector<std::array<uint32_t, 3>> m_Triangles;
+			std::vector<uint8_t> m_TriangleAlive;
+			size_t m_LiveTriangles = 0;
+
+			// Scratch space for Collapse
+			std::vector<std::pair<uint32_t, uint32_t>> m_WedgeMap;
+			std::vector<uint32_t> m_Neighbours;
+			std::vector<uint32_t> m_CommonNeighbours;
+		};
+
+	}
+
+	ParsedMeshData MeshSimplifier::Simplify(const ParsedMeshData& mesh, const float targetRatio)
+	{
+		AR_CORE_ASSERT(targetRatio > 0.0f && targetRatio <= 1.0f, "Target ratio must be in (0, 1]!");
+
+		Simplifier simplifier(mesh);
+		const size_t targetTriangles = std::max<size_t>(static_cast<size_t>(static_cast<double>(simplifier.GetTriangleCount()) * targetRatio), 1);
+		simplifier.Simplify(targetTriangles);
+		return simplifier.GetResult();
+	}
+
+	std::vector<ParsedMeshData> MeshSimplifier::Simplify(const ParsedMeshData& mesh, const std::vector<float>& targetRatios)
+	{
+		std::vector<ParsedMeshData> results(targetRatios.size());
+		ThreadPool::ParallelFor(targetRatios.size(), 1, [&mesh, &targetRatios, &results](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+				results[i] = Simplify(mesh, targetRatios[i]);
+		});
+		return results;
+	}
+
+}
\ No newline at end of file
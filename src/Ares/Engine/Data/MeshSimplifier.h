@@ -0,0 +1,53 @@
+/**
+ * @file MeshSimplifier.h
+ * @brief Declaration of the MeshSimplifier class, which reduces the triangle count of parsed
+ * meshes to generate levels of detail.
+ *
+ * @details Simplification uses quadric error metrics with half-edge collapses: every vertex
+ * accumulates the planes of its triangles, and the cheapest edges (by the squared distance of the
+ * kept vertex to the planes of both ends) are collapsed first.
+ *
+ * Vertices are welded by their attributes first, so a position can have several vertices (wedges)
+ * with different texture coordinates or normals. Collapses never mix wedges across such attribute
+ * seams: a seam vertex can only slide along its seam, seam corners and open borders are kept in
+ * place or move along the border, so UV islands and hard edges survive simplification.
+ */
+#pragma once
+
+namespace Ares {
+
+	struct ParsedMeshData;
+
+	/**
+	 * @class MeshSimplifier
+	 * @brief Static helpers simplifying ParsedMeshData, offline or while loading assets.
+	 */
+	class MeshSimplifier
+	{
+	public:
+		MeshSimplifier() = delete;
+
+		/**
+		 * @brief Simplifies a mesh down to a fraction of its triangles.
+		 *
+		 * @details The result is indexed and only contains the attributes the source mesh has.
+		 * Simplification stops early when no collapse is possible without breaking a seam,
+		 * border or flipping a triangle, so the result can have more triangles than requested.
+		 *
+		 * @param mesh The mesh to simplify.
+		 * @param targetRatio Fraction of the triangles to keep, in (0, 1].
+		 * @return The simplified mesh.
+		 */
+		static ParsedMeshData Simplify(const ParsedMeshData& mesh, const float targetRatio);
+
+		/**
+		 * @brief Simplifies a mesh to several target ratios at once, in parallel on the ThreadPool.
+		 *
+		 * @param mesh The mesh to simplify.
+		 * @param targetRatios Fraction of the triangles to keep for each result.
+		 * @return One simplified mesh per target ratio, in the same order.
+		 */
+		static std::vector<ParsedMeshData> Simplify(const ParsedMeshData& mesh, const std::vector<float>& targetRatios);
+	};
+
+}
\ No newline at end of file
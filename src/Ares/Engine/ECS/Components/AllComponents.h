@@ -1,6 +1,8 @@
 #pragma once
 #include "Engine/ECS/Components/Camera.h"
+#include "Engine/ECS/Components/Hierarchy.h"
 #include "Engine/ECS/Components/Light.h"
 #include "Engine/ECS/Components/Material.h"
 #include "Engine/ECS/Components/Mesh.h"
+#include "Engine/ECS/Components/Occluder.h"
 #include "Engine/ECS/Components/Transform.h"
\ No newline at end of file
@@ -17,136 +17,97 @@ namespace Ares::ECS::Components {
 
 	Camera::Mode Camera::GetMode() const
 	{
-		std::shared_lock lock(m_Mutex);
 		return m_Mode;
 	}
 
 	glm::vec3 Camera::GetPosition() const
 	{
-		std::shared_lock lock(m_Mutex);
 		return m_Position;
 	}
 
 	glm::quat Camera::GetRotation() const
 	{
-		std::shared_lock lock(m_Mutex);
 		return m_Rotation;
 	}
 
 	glm::vec2 Camera::GetNearFarPlanes() const
 	{
-		std::shared_lock lock(m_Mutex);
 		return glm::vec2(m_NearPlane, m_FarPlane);
 	}
 
 	glm::vec2 Camera::GetViewportSize() const
 	{
-		std::shared_lock lock(m_Mutex);
 		return m_ViewportSize;
 	}
 
 	float Camera::GetOrthoZoom() const
 	{
-		std::shared_lock lock(m_Mutex);
 		return m_OrthoZoom;
 	}
 
 	float Camera::GetPerspectiveFov() const
 	{
-		std::shared_lock lock(m_Mutex);
 		return m_PerspectiveFov;
 	}
 
-	glm::mat4 Camera::GetViewProjectionMatrix()
+	glm::mat4 Camera::GetViewProjectionMatrix() const
 	{
-		CalculateViewProjectionMatrix();
-		std::shared_lock lock(m_Mutex);
 		return m_ViewProjectionMatrix;
 	}
 
 	void Camera::SetPosition(const glm::vec3& position)
 	{
-		{
-			std::shared_lock lock(m_Mutex);
-			if (m_Position == position)
-				return;
-		}
-		{
-			std::unique_lock lock(m_Mutex);
-			m_Position = position;
-			m_ViewMatrixDirty = true;
-		}
+		if (m_Position == position)
+			return;
+
+		m_Position = position;
+		m_ViewMatrixDirty = true;
 	}
 
 	void Camera::SetRotation(const glm::quat& rotation)
 	{
-		{
-			std::shared_lock lock(m_Mutex);
-			if (m_Rotation == rotation)
-				return;
-		}
-		{
-			std::unique_lock lock(m_Mutex);
-			m_Rotation = rotation;
-			m_ViewMatrixDirty = true;
-		}
+		if (m_Rotation == rotation)
+			return;
+
+		m_Rotation = rotation;
+		m_ViewMatrixDirty = true;
 	}
 
 	void Camera::SetNearFarPlanes(const glm::vec2& planes)
 	{
-		{
-			std::shared_lock lock(m_Mutex);
-			if (m_NearPlane == planes.x && m_FarPlane == planes.y)
-				return;
-		}
-		{
-			std::unique_lock lock(m_Mutex);
-			m_NearPlane = planes.x;
-			m_FarPlane = planes.y;
-			m_ProjectionMatrixDirty = true;
-		}
+		if (m_NearPlane == planes.x && m_FarPlane == planes.y)
+			return;
+
+		m_NearPlane = planes.x;
+		m_FarPlane = planes.y;
+		m_ProjectionMatrixDirty = true;
 	}
 
 	void Camera::SetViewportSize(const glm::vec2& viewSize)
 	{
-		{
-			std::shared_lock lock(m_Mutex);
-			if (m_ViewportSize == viewSize)
-				return;
-		}
-		{
-			std::unique_lock lock(m_Mutex);
-			m_ViewportSize = viewSize;
-			m_ProjectionMatrixDirty = true;
-		}
+		if (m_ViewportSize == viewSize)
+			return;
+
+		m_ViewportSize = viewSize;
+		m_ProjectionMatrixDirty = true;
 	}
 
 	void Camera::SetOrthoZoom(const float zoom)
 	{
-		{
-			std::shared_lock lock(m_Mutex);
-			if (m_OrthoZoom == zoom)
-				return;
-		}
-		{
-			std::unique_lock lock(m_Mutex);
-			m_OrthoZoom = zoom;
-			m_ProjectionMatrixDirty = true;
-		}
+		if (m_OrthoZoom == zoom)
+			return;
+
+		m_OrthoZoom = zoom;
+		m_ProjectionMatrixDirty = true;
 	}
 
 	void Camera::SetPerspectiveFov(const float fov)
 	{
-		{
-			std::shared_lock lock(m_Mutex);
-			if (m_PerspectiveFov == fov)
-				return;
-		}
-		{
-			std::unique_lock lock(m_Mutex);
-			m_PerspectiveFov = fov;
-			m_ProjectionMatrixDirty = true;
-		}
+		if (m_PerspectiveFov == fov)
+			return;
+
+		m_PerspectiveFov = fov;
+		m_ProjectionMatrixDirty = true;
 	}
 
 	void Camera::SetOrthographic(
@@ -155,7 +116,6 @@ namespace Ares::ECS::Components {
 		const float nearPlane, const float farPlane
 	)
 	{
-		std::unique_lock lock(m_Mutex);
 		m_ViewportSize = viewSize;
 		m_OrthoZoom = zoom;
 		m_NearPlane = nearPlane;
@@ -170,7 +130,6 @@ namespace Ares::ECS::Components {
 		const float nearPlane, const float farPlane
 	)
 	{
-		std::unique_lock lock(m_Mutex);
 		m_ViewportSize = viewSize;
 		m_PerspectiveFov = fov;
 		m_NearPlane = nearPlane;
@@ -179,11 +138,16 @@ namespace Ares::ECS::Components {
 		m_Mode = Mode::Perspective;
 	}
 
+	bool Camera::IsDirty() const
+	{
+		return m_ViewMatrixDirty || m_ProjectionMatrixDirty || m_ViewProjectionMatrixDirty;
+	}
+
 	void Camera::CalculateViewMatrix()
 	{
-		if (m_ViewMatrixDirty.exchange(false))
+		if (m_ViewMatrixDirty)
 		{
-			std::unique_lock lock(m_Mutex);
+			m_ViewMatrixDirty = false;
 			glm::mat4 translation;
 			glm::mat4 rotation;
 
@@ -197,9 +161,9 @@ namespace Ares::ECS::Components {
 
 	void Camera::CalculateProjectionMatrix()
 	{
-		if (m_ProjectionMatrixDirty.exchange(false))
+		if (m_ProjectionMatrixDirty)
 		{
-			std::unique_lock lock(m_Mutex);
+			m_ProjectionMatrixDirty = false;
 			if (m_Mode == Mode::Orthographic)
 			{
 				float aspectRatio = m_ViewportSize.x / m_ViewportSize.y;
@@ -228,9 +192,9 @@ namespace Ares::ECS::Components {
 		CalculateViewMatrix();
 		CalculateProjectionMatrix();
 
-		if (m_ViewProjectionMatrixDirty.exchange(false))
+		if (m_ViewProjectionMatrixDirty)
 		{
-			std::unique_lock lock(m_Mutex);
+			m_ViewProjectionMatrixDirty = false;
 			m_ViewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix;
 		}
 	}
@@ -6,6 +6,12 @@
 
 #include "Engine/ECS/Core/Component.h"
 
+namespace Ares::ECS::Systems {
+
+	class CameraSystem;
+
+}
+
 namespace Ares::ECS::Components {
 
 	class Camera : public Component
@@ -20,7 +26,7 @@ namespace Ares::ECS::Components {
 		// Constructor
 		Camera(Mode mode = Perspective);
 
-		// Getters - Using shared locks for read operations
+		// Getters
 		Mode GetMode() const;
 		glm::vec3 GetPosition() const;
 		glm::quat GetRotation() const;
@@ -28,9 +34,10 @@ namespace Ares::ECS::Components {
 		glm::vec2 GetViewportSize() const;
 		float GetOrthoZoom() const;
 		float GetPerspectiveFov() const;
-		glm::mat4 GetViewProjectionMatrix();
+		// View projection matrix as of the last CameraSystem update
+		glm::mat4 GetViewProjectionMatrix() const;
 
-		// Setters - Using unique locks for write operations
+		// Setters
 		void SetPosition(const glm::vec3& position);
 		void SetRotation(const glm::quat& rotation);
 		void SetNearFarPlanes(const glm::vec2& planes);
@@ -51,14 +58,12 @@ namespace Ares::ECS::Components {
 		);
 
 	private:
+		bool IsDirty() const;
 		void CalculateViewMatrix();
 		void CalculateProjectionMatrix();
 		void CalculateViewProjectionMatrix();
 
 	private:
-		// Mutex for thread safety
-		mutable std::shared_mutex m_Mutex;
-
 		// Projection type
 		Mode m_Mode;
 
@@ -84,9 +89,14 @@ namespace Ares::ECS::Components {
 		glm::mat4 m_ViewProjectionMatrix;
 
 		// Are matrices dirty
-		std::atomic<bool> m_ViewMatrixDirty = true;
-		std::atomic<bool> m_ProjectionMatrixDirty = true;
-		std::atomic<bool> m_ViewProjectionMatrixDirty = true;
+		bool m_ViewMatrixDirty = true;
+		bool m_ProjectionMatrixDirty = true;
+		bool m_ViewProjectionMatrixDirty = true;
+
+		// Computes the matrices of the active camera
+		friend class Systems::CameraSystem;
 	};
 
+	static_assert(std::is_trivially_copyable_v<Camera>, "Camera must be trivially copyable!");
+
 }
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include "Engine/ECS/Core/Component.h"
+
+namespace Ares::ECS::Components {
+
+	// Parent of an entity in the scene hierarchy.
+	// Use TransformSystem::SetParent to change the hierarchy so Parent & Children stay in sync.
+	struct Parent : public Component
+	{
+		Parent(const uint32_t entityId = 0)
+			: EntityId(entityId)
+		{
+		}
+
+		uint32_t EntityId;
+	};
+
+	// Direct children of an entity in the scene hierarchy
+	struct Children : public Component
+	{
+		std::vector<uint32_t> EntityIds;
+	};
+
+}
\ No newline at end of file
@@ -39,10 +39,11 @@ namespace Ares::ECS::Components {
 		void SetOuterAngle(const float outerAngle);
 
 	private:
-		mutable std::shared_mutex m_Mutex;
 		Type m_Type;
 		glm::vec4 m_Color;
 		glm::vec4 m_Properties;
 	};
 
+	static_assert(std::is_trivially_copyable_v<Light>, "Light must be trivially copyable!");
+
 }
\ No newline at end of file
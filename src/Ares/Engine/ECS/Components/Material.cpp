@@ -4,6 +4,7 @@
 #include "Engine/Data/AssetManager.h"
 #include "Engine/Renderer/Assets/Texture.h"
 #include "Engine/Renderer/Assets/Shader.h"
+#include "Engine/Utility/Hash.h"
 
 namespace Ares::ECS::Components {
 
@@ -21,29 +22,11 @@ namespace Ares::ECS::Components {
 		}
 
 		m_ShaderAsset = shaderAsset;
-	}
-
-	Material::Material(const Material& other)
-	{
-		std::shared_lock lock(other.m_Mutex);
-		m_ShaderAsset = other.m_ShaderAsset;
-		m_Properties = other.m_Properties;
-		m_TextureAssets = other.m_TextureAssets;
-	}
-
-	Material& Material::operator=(const Material& other)
-	{
-		std::shared_lock lock(other.m_Mutex);
-		std::unique_lock lock1(m_Mutex);
-		m_ShaderAsset = other.m_ShaderAsset;
-		m_Properties = other.m_Properties;
-		m_TextureAssets = other.m_TextureAssets;
-		return *this;
+		UpdateBatchKey();
 	}
 
 	std::string Material::GetShaderName() const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_ShaderAsset != nullptr)
 			return m_ShaderAsset->GetName();
 
@@ -52,16 +35,14 @@ namespace Ares::ECS::Components {
 
 	size_t Material::GetShaderSize() const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_ShaderAsset != nullptr)
 			return m_ShaderAsset->GetDataSize();
 
 		return 0;
 	}
 
-	MaterialProperties Material::GetProperties() const
+	const MaterialProperties& Material::GetProperties() const
 	{
-		std::shared_lock lock(m_Mutex);
 		return m_MaterialProperties;
 	}
 
@@ -73,15 +54,23 @@ namespace Ares::ECS::Components {
 			return;
 		}
 
-		std::unique_lock lock(m_Mutex);
 		m_ShaderAsset = asset;
+		UpdateBatchKey();
 	}
 
 	template <typename PropertyType>
-	void Material::SetUniformProperty(const std::string& name, const PropertyType& value)
+	void Material::SetUniformProperty(const std::string_view name, const PropertyType& value)
 	{
-		std::unique_lock lock(m_Mutex);
-		m_Properties[name] = value;
+		const UniformID id(name);
+		for (UniformProperty& property : m_Properties)
+		{
+			if (property.Id == id)
+			{
+				property.Value = value;
+				return;
+			}
+		}
+		m_Properties.push_back({ std::string(name), id, value });
 	}
 
 	void Material::SetTexture(const std::string& name, const Ref<Asset>& texture)
@@ -92,19 +81,17 @@ namespace Ares::ECS::Components {
 			return;
 		}
 
-		std::unique_lock lock(m_Mutex);
 		m_TextureAssets[name] = texture;
+		UpdateBatchKey();
 	}
 
 	void Material::SetProperties(const MaterialProperties& props)
 	{
-		std::unique_lock lock(m_Mutex);
 		m_MaterialProperties = props;
 	}
 
 	bool Material::IsLoaded() const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_ShaderAsset != nullptr && m_ShaderAsset->GetState() == AssetState::Loaded)
 		{
 			for (auto& texture : m_TextureAssets)
@@ -119,7 +106,6 @@ namespace Ares::ECS::Components {
 
 	bool Material::IsValid() const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_ShaderAsset != nullptr)
 			return true;
 
@@ -128,7 +114,6 @@ namespace Ares::ECS::Components {
 
 	void Material::PreCache() const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_ShaderAsset != nullptr && m_ShaderAsset->GetState() == AssetState::Staged)
 		{
 			AssetManager::Load(m_ShaderAsset);
@@ -142,9 +127,8 @@ namespace Ares::ECS::Components {
 		}
 	}
 
-	void Material::Bind() const
+	void Material::Bind(const bool bindShader, const bool bindTextures) const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_ShaderAsset->GetState() != AssetState::Loaded)
 		{
 			AR_CORE_WARN("Material's Shader Program is not loaded - Not Binding!");
@@ -160,23 +144,27 @@ namespace Ares::ECS::Components {
 			return;
 		}
 
-		shader->Bind();
+		if (bindShader)
+			shader->Bind();
 
 		// Set properties based on type
-		for (const auto& [name, value] : m_Properties)
+		for (const auto& [name, id, value] : m_Properties)
 		{
-			std::visit([this, shader, &name](auto&& arg) {
+			std::visit([this, shader, id](auto&& arg) {
 				using T = std::decay_t<decltype(arg)>;
-				if constexpr (std::is_same_v<T, int32_t>) shader->SetInt(name, arg);
-				else if constexpr (std::is_same_v<T, float>) shader->SetFloat(name, arg);
-				else if constexpr (std::is_same_v<T, glm::vec2>) shader->SetFloat2(name, arg);
-				else if constexpr (std::is_same_v<T, glm::vec3>) shader->SetFloat3(name, arg);
-				else if constexpr (std::is_same_v<T, glm::vec4>) shader->SetFloat4(name, arg);
-				else if constexpr (std::is_same_v<T, glm::mat3>) shader->SetMat3(name, arg);
-				else if constexpr (std::is_same_v<T, glm::mat4>) shader->SetMat4(name, arg);
+				if constexpr (std::is_same_v<T, int32_t>) shader->SetInt(id, arg);
+				else if constexpr (std::is_same_v<T, float>) shader->SetFloat(id, arg);
+				else if constexpr (std::is_same_v<T, glm::vec2>) shader->SetFloat2(id, arg);
+				else if constexpr (std::is_same_v<T, glm::vec3>) shader->SetFloat3(id, arg);
+				else if constexpr (std::is_same_v<T, glm::vec4>) shader->SetFloat4(id, arg);
+				else if constexpr (std::is_same_v<T, glm::mat3>) shader->SetMat3(id, arg);
+				else if constexpr (std::is_same_v<T, glm::mat4>) shader->SetMat4(id, arg);
 			}, value);
 		}
 
+		if (!bindTextures)
+			return;
+
 		// Bind textures
 		int32_t textureUnit = 0;
 		for (const auto& [name, texture] : m_TextureAssets)
@@ -194,11 +182,18 @@ namespace Ares::ECS::Components {
 		}
 	}
 
-	template void Material::SetUniformProperty<int32_t>(const std::string&, const int32_t&);
-	template void Material::SetUniformProperty<float>(const std::string&, const float&);
-	template void Material::SetUniformProperty<glm::vec2>(const std::string&, const glm::vec2&);
-	template void Material::SetUniformProperty<glm::vec3>(const std::string&, const glm::vec3&);
-	template void Material::SetUniformProperty<glm::mat3>(const std::string&, const glm::mat3&);
-	template void Material::SetUniformProperty<glm::mat4>(const std::string&, const glm::mat4&);
+	void Material::UpdateBatchKey()
+	{
+		// Hashing walks every texture name, so it's done here instead of every time the key is read
+		m_BatchKey = m_ShaderAsset != nullptr ? std::hash<Material>{}(*this) : 0;
+	}
+
+	template void Material::SetUniformProperty<int32_t>(const std::string_view, const int32_t&);
+	template void Material::SetUniformProperty<float>(const std::string_view, const float&);
+	template void Material::SetUniformProperty<glm::vec2>(const std::string_view, const glm::vec2&);
+	template void Material::SetUniformProperty<glm::vec3>(const std::string_view, const glm::vec3&);
+	template void Material::SetUniformProperty<glm::vec4>(const std::string_view, const glm::vec4&);
+	template void Material::SetUniformProperty<glm::mat3>(const std::string_view, const glm::mat3&);
+	template void Material::SetUniformProperty<glm::mat4>(const std::string_view, const glm::mat4&);
 
 }
\ No newline at end of file
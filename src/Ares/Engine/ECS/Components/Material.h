@@ -8,10 +8,13 @@
 
 #include "Engine/ECS/Components/MaterialProperties.h"
 #include "Engine/ECS/Core/Component.h"
+#include "Engine/Renderer/ShaderUniforms.h"
 
 namespace Ares {
 
 	class Asset;
+
+	namespace ECS { class SceneSerializer; }
 	
 	namespace ECS::Components {
 
@@ -22,19 +25,18 @@ namespace Ares {
 			Material();
 			Material(const Ref<Asset>& shaderAsset);
 
-			// Copy constructors
-			Material(const Material& other);
-			Material& operator=(const Material& other);
-
 			// Getters
 			std::string GetShaderName() const;
+			inline const Ref<Asset>& GetShaderAsset() const { return m_ShaderAsset; }
 			size_t GetShaderSize() const;
-			MaterialProperties GetProperties() const;
+			const MaterialProperties& GetProperties() const;
+			// Hash of the shader & textures, recomputed only when they change
+			inline size_t GetBatchKey() const { return m_BatchKey; }
 
 			// Material properties
 			void SetShader(const Ref<Asset>& asset);
 			template <typename PropertyType>
-			void SetUniformProperty(const std::string& name, const PropertyType& value);
+			void SetUniformProperty(const std::string_view name, const PropertyType& value);
 			void SetTexture(const std::string& name, const Ref<Asset>& texture);
 			void SetProperties(const MaterialProperties& props);
 
@@ -43,24 +45,34 @@ namespace Ares {
 			bool IsValid() const;
 			void PreCache() const;
 
-			void Bind() const;
+			// Shader & textures can be left out when the previous material already bound the same ones
+			void Bind(const bool bindShader = true, const bool bindTextures = true) const;
 
 		private:
-			// Mutex for thread-safety
-			mutable std::shared_mutex m_Mutex;
+			void UpdateBatchKey();
 
+		private:
 			// Material assets
 			Ref<Asset> m_ShaderAsset;
 			std::unordered_map<std::string, Ref<Asset>> m_TextureAssets;
 
-			// Uniform properties
-			std::unordered_map<std::string, std::variant<int32_t, float, glm::vec2, glm::vec3, glm::vec4, glm::mat3, glm::mat4>> m_Properties;
+			// Uniform properties, a flat array since materials only have a few. The name is kept for
+			// saving, binding only uses the id
+			struct UniformProperty
+			{
+				std::string Name;
+				UniformID Id;
+				std::variant<int32_t, float, glm::vec2, glm::vec3, glm::vec4, glm::mat3, glm::mat4> Value;
+			};
+			std::vector<UniformProperty> m_Properties;
 
 			// Material properties
 			MaterialProperties m_MaterialProperties;
 
 			// Hash
+			size_t m_BatchKey = 0;
 			friend struct std::hash<Material>;
+			friend class ECS::SceneSerializer;
 		};
 
 	}
@@ -1,86 +1,39 @@
 #pragma once
 #include <glm/vec3.hpp>
 
+namespace Ares { class BufferLayout; }
+
 namespace Ares::ECS::Components {
 
-	class MaterialProperties
+	// Per instance material properties, uploaded as-is as instanced vertex attributes.
+	// The members are tightly packed and follow GetBufferLayout() element for element.
+	struct MaterialProperties
 	{
-	private:
-		std::vector<uint8_t> m_Buffer;
-
-		class BasicPropsProxy
+		struct BasicProps
 		{
-		public:
-			glm::vec3& Color;
-			float& Alpha;
-
-			BasicPropsProxy(uint8_t* data);
-
-			BasicPropsProxy(const BasicPropsProxy& other) = delete;
-			BasicPropsProxy& operator=(const BasicPropsProxy& other);
-
-		private:
-			uint8_t* m_Data;
-		};
-
-		class SurfacePropsProxy
-		{
-		public:
-			float& Roughness;
-			float& Metallic;
-			float& Reflectivity;
-			glm::vec3& EmissiveColor;
-			float& EmissiveIntensity;
-
-			SurfacePropsProxy(uint8_t* data);
-
-			SurfacePropsProxy(const SurfacePropsProxy& other) = delete;
-			SurfacePropsProxy& operator=(const SurfacePropsProxy& other);
-
-		private:
-			uint8_t* m_Data;
+			glm::vec3 Color = { 1.0f, 1.0f, 1.0f };
+			float Alpha = 1.0f;
 		};
 
-		/*
-		class RenderPropsProxy
+		struct SurfaceProps
 		{
-		public:
-			struct BoolProp
-			{
-				int32_t& value;
-
-				BoolProp(uint8_t* data) : value(*reinterpret_cast<int32_t*>(data)) {}
-
-				operator bool() const { return value != 0; }
-				BoolProp& operator=(bool setVal) { value = setVal ? 1 : 0; return *this; }
-				BoolProp& operator=(const BoolProp& other) { value = other.value; return *this; }
-			};
-			BoolProp ReceiveShadows;
-			BoolProp CastShadows;
-			BoolProp Wireframe;
-
-			RenderPropsProxy(uint8_t* data);
-
-			RenderPropsProxy(const RenderPropsProxy& other) = delete;
-			RenderPropsProxy& operator=(const RenderPropsProxy& other);
-
-		private:
-			uint8_t* m_Data;
+			float Roughness = 0.2f;
+			float Metallic = 0.1f;
+			float Reflectivity = 0.1f;
+			glm::vec3 EmissiveColor = { 1.0f, 1.0f, 1.0f };
+			float EmissiveIntensity = 0.0f;
 		};
-		*/
 
-	public:
-		BasicPropsProxy Basic;
-		SurfacePropsProxy Surface;
-		//RenderPropsProxy Render;
+		BasicProps Basic;
+		SurfaceProps Surface;
 
-		MaterialProperties();
+		inline const void* GetBuffer() const { return this; }
+		static constexpr size_t GetSize() { return sizeof(MaterialProperties); }
 
-		const void* GetBuffer() const;
-		size_t GetSize() const;
-
-		MaterialProperties(const MaterialProperties& other);
-		MaterialProperties& operator=(const MaterialProperties& other);
+		// Layout of the instanced attributes, its stride & offsets match this struct
+		static const BufferLayout& GetBufferLayout();
 	};
 
+	static_assert(std::is_trivially_copyable_v<MaterialProperties>, "MaterialProperties must be trivially copyable!");
+
 }
\ No newline at end of file
@@ -5,17 +5,40 @@
 #include "Engine/Renderer/Buffer.h"
 #include "Engine/Renderer/BufferLayout.h"
 #include "Engine/Renderer/Assets/MeshData.h"
+#include "Engine/Utility/Hash.h"
 
 namespace Ares::ECS::Components {
 
 	Mesh::Mesh(const Ref<Asset>& asset)
 	{
-		if (asset->GetType() != typeid(MeshData))
+		// A null asset makes an invalid mesh (e.g. a scene referencing a missing asset)
+		if (asset != nullptr && asset->GetType() != typeid(MeshData))
 		{
 			AR_CORE_ASSERT(false, "Asset must be Mesh Data!");
 			return;
 		}
 		m_MeshAsset = asset;
+		UpdateBatchKey();
+	}
+
+	Mesh::Mesh(const Ref<MeshLODChain>& lodChain)
+	{
+		if (lodChain == nullptr || lodChain->Levels.empty())
+		{
+			AR_CORE_ASSERT(false, "LOD chain must have at least one level!");
+			return;
+		}
+		for (const MeshLODChain::Level& level : lodChain->Levels)
+		{
+			if (level.MeshAsset == nullptr || level.MeshAsset->GetType() != typeid(MeshData))
+			{
+				AR_CORE_ASSERT(false, "LOD assets must be Mesh Data!");
+				return;
+			}
+		}
+		m_LODChain = lodChain;
+		m_MeshAsset = lodChain->Levels[0].MeshAsset;
+		UpdateBatchKey();
 	}
 
 	VertexBuffer* Mesh::GetPositionBuffer() const
@@ -35,7 +58,6 @@ namespace Ares::ECS::Components {
 
 	IndexBuffer* Mesh::GetIndexBuffer() const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_MeshAsset != nullptr && m_MeshAsset->GetState() == AssetState::Loaded)
 			return m_MeshAsset->GetAsset<MeshData>()->GetIndexBuffer();
 
@@ -44,25 +66,50 @@ namespace Ares::ECS::Components {
 
 	std::string Mesh::GetMeshName() const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_MeshAsset != nullptr)
 			return m_MeshAsset->GetName();
 
 		return "NULL";
 	}
 
+	AABB Mesh::GetBounds() const
+	{
+		if (m_MeshAsset != nullptr && m_MeshAsset->GetState() == AssetState::Loaded)
+			return m_MeshAsset->GetAsset<MeshData>()->GetBounds();
+
+		return AABB();
+	}
+
 	size_t Mesh::GetMeshSize() const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_MeshAsset != nullptr)
 			return m_MeshAsset->GetDataSize();
 
 		return 0;
 	}
 
+	bool Mesh::SetLODLevel(const uint32_t level)
+	{
+		if (m_LODChain == nullptr || level == m_LODLevel || level >= m_LODChain->Levels.size())
+			return false;
+
+		// Keep drawing the current level until the new one is ready
+		const Ref<Asset>& asset = m_LODChain->Levels[level].MeshAsset;
+		if (asset->GetState() != AssetState::Loaded)
+		{
+			if (asset->GetState() == AssetState::Staged)
+				AssetManager::Load(asset);
+			return false;
+		}
+
+		m_MeshAsset = asset;
+		m_LODLevel = level;
+		UpdateBatchKey();
+		return true;
+	}
+
 	bool Mesh::IsLoaded() const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_MeshAsset != nullptr && m_MeshAsset->GetState() == AssetState::Loaded)
 			return true;
 
@@ -71,7 +118,6 @@ namespace Ares::ECS::Components {
 
 	bool Mesh::IsValid() const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_MeshAsset != nullptr)
 			return true;
 
@@ -80,14 +126,12 @@ namespace Ares::ECS::Components {
 
 	void Mesh::PreCache() const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_MeshAsset != nullptr && m_MeshAsset->GetState() == AssetState::Staged)
 			AssetManager::Load(m_MeshAsset);
 	}
 
 	VertexBuffer* Mesh::GetBuffer(VertexDataType type) const
 	{
-		std::shared_lock lock(m_Mutex);
 		if (m_MeshAsset != nullptr && m_MeshAsset->GetState() == AssetState::Loaded)
 		{
 			return m_MeshAsset->GetAsset<MeshData>()->GetVertexBuffer(type);
@@ -95,4 +139,9 @@ namespace Ares::ECS::Components {
 		return nullptr;
 	}
 
+	void Mesh::UpdateBatchKey()
+	{
+		m_BatchKey = m_MeshAsset != nullptr ? std::hash<Mesh>{}(*this) : 0;
+	}
+
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include "Engine/Core/Bounds.h"
 #include "Engine/ECS/Core/Component.h"
 
 namespace Ares {
@@ -7,13 +8,31 @@ namespace Ares {
 	class VertexBuffer;
 	class IndexBuffer;
 	enum class VertexDataType : uint8_t;
+
+	namespace ECS { class SceneSerializer; }
 	
 	namespace ECS::Components {
 
+		// Mesh Data assets of decreasing detail, shared by every Mesh using them.
+		// Level i is used while the mesh's projected size is at least its ScreenSize (the fraction of
+		// the screen height covered by the bounding sphere), so levels go from the largest size down.
+		struct MeshLODChain
+		{
+			struct Level
+			{
+				Ref<Asset> MeshAsset = nullptr;
+				float ScreenSize = 0.0f;
+			};
+
+			std::vector<Level> Levels;
+		};
+
 		class Mesh : public Component
 		{
 		public:
 			Mesh(const Ref<Asset>& asset);
+			// Starts at the most detailed level, the LODSystem picks the level from then on
+			Mesh(const Ref<MeshLODChain>& lodChain);
 
 			// Getters
 			VertexBuffer* GetPositionBuffer() const;
@@ -22,6 +41,16 @@ namespace Ares {
 			IndexBuffer* GetIndexBuffer() const;
 			std::string GetMeshName() const;
 			size_t GetMeshSize() const;
+			// Hash of the current level's asset, recomputed only when it changes
+			inline size_t GetBatchKey() const { return m_BatchKey; }
+			// Model space bounds, invalid until the mesh is loaded
+			AABB GetBounds() const;
+
+			// Level of detail, the getters above all refer to the current level
+			inline const Ref<MeshLODChain>& GetLODChain() const { return m_LODChain; }
+			inline uint32_t GetLODLevel() const { return m_LODLevel; }
+			// Switches to another level once its asset is loaded (loading it otherwise), returns true if switched
+			bool SetLODLevel(const uint32_t level);
 
 			// Asset properties
 			bool IsLoaded() const;
@@ -30,16 +59,18 @@ namespace Ares {
 
 		private:
 			VertexBuffer* GetBuffer(VertexDataType type) const;
+			void UpdateBatchKey();
 
 		private:
-			// Mutex for thread safety
-			mutable std::shared_mutex m_Mutex;
-
 			// Mesh properties
 			Ref<Asset> m_MeshAsset = nullptr;
+			Ref<MeshLODChain> m_LODChain = nullptr;
+			uint32_t m_LODLevel = 0;
 
 			//Hash
+			size_t m_BatchKey = 0;
 			friend struct std::hash<Mesh>;
+			friend class ECS::SceneSerializer;
 		};
 
 	}
@@ -0,0 +1,40 @@
+#pragma once
+#include "Engine/Core/Bounds.h"
+#include "Engine/ECS/Core/Component.h"
+
+namespace Ares::ECS::Components {
+
+	// Marks an entity as an occluder for the RenderSystem's software occlusion culling.
+	// The geometry is a low polygon stand-in in model space (transformed by the entity's Transform)
+	// and must stay inside the visible mesh, otherwise it can hide things that should be visible.
+	struct Occluder : public Component
+	{
+		std::vector<glm::vec3> Vertices;
+		// Triangle list
+		std::vector<uint32_t> Indices;
+
+		// Occluder for solid, box shaped meshes (walls, buildings, ...)
+		static Occluder Box(const AABB& box)
+		{
+			Occluder occluder;
+			for (uint32_t corner = 0; corner < 8; corner++)
+			{
+				occluder.Vertices.emplace_back(
+					corner & 1 ? box.Max.x : box.Min.x,
+					corner & 2 ? box.Max.y : box.Min.y,
+					corner & 4 ? box.Max.z : box.Min.z
+				);
+			}
+			occluder.Indices = {
+				0, 2, 1, 1, 2, 3,	// -Z
+				4, 5, 6, 5, 7, 6,	// +Z
+				0, 1, 4, 1, 5, 4,	// -Y
+				2, 6, 3, 3, 6, 7,	// +Y
+				0, 4, 2, 2, 4, 6,	// -X
+				1, 3, 5, 3, 7, 5	// +X
+			};
+			return occluder;
+		}
+	};
+
+}
\ No newline at end of file
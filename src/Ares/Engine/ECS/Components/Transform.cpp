@@ -7,40 +7,50 @@ namespace Ares::ECS::Components {
 		: m_Position(glm::vec3(0.0f)),
 		m_Rotation(glm::quat(1.0f, 0.0f, 0.0f, 0.0f)),
 		m_Scale(glm::vec3(1.0f)),
-		m_TranslationMatrix(glm::mat4(1.0f)),
-		m_RotationMatrix(glm::mat4(1.0f)),
-		m_ScaleMatrix(glm::mat4(1.0f)),
-		m_TranslationDirty(true),
-		m_RotationDirty(true),
-		m_ScaleDirty(true),
-		m_TransformationDirty(true)
+		m_TransformationMatrix(glm::mat4(1.0f)),
+		m_WorldMatrix(glm::mat4(1.0f)),
+		m_TransformationDirty(false),
+		m_WorldDirty(false),
+		m_HasParent(false)
 	{
-		CalculateTransformationMatrix();
 	}
 
 	glm::mat4 Transform::GetTransformationMatrix()
 	{
 		CalculateTransformationMatrix();
+		return m_TransformationMatrix;
+	}
+
+	glm::mat4 Transform::GetWorldMatrix() const
+	{
+		if (m_HasParent)
+			return m_WorldMatrix;
+
+		// A root written since the last update is composed without caching it, const readers
+		// (culling, spatial index, LOD) can run in parallel
+		if (m_TransformationDirty)
+			return ComposeMatrix();
 
-		std::shared_lock lock(m_Mutex);
 		return m_TransformationMatrix;
 	}
 
+	bool Transform::HasParent() const
+	{
+		return m_HasParent;
+	}
+
 	glm::vec3 Transform::GetPosition() const
 	{
-		std::shared_lock lock(m_Mutex);
 		return m_Position;
 	}
 
 	glm::quat Transform::GetRotation() const
 	{
-		std::shared_lock lock(m_Mutex);
 		return m_Rotation;
 	}
 
 	glm::vec3 Transform::GetScale() const
 	{
-		std::shared_lock lock(m_Mutex);
 		return m_Scale;
 	}
 
@@ -53,16 +63,12 @@ namespace Ares::ECS::Components {
 
 	void Transform::SetPosition(const glm::vec3& position)
 	{
-		{
-			std::shared_lock lock(m_Mutex);
-			if (m_Position == position)
-				return;
-		}
-		{
-			std::unique_lock lock(m_Mutex);
-			m_Position = position;
-			m_TranslationDirty = true;
-		}
+		if (m_Position == position)
+			return;
+
+		m_Position = position;
+		m_TransformationDirty = true;
+		m_WorldDirty = true;
 	}
 
 	void Transform::SetPosition(const Transform* transform)
@@ -72,16 +78,12 @@ namespace Ares::ECS::Components {
 
 	void Transform::SetRotation(const glm::quat& rotation)
 	{
-		{
-			std::shared_lock lock(m_Mutex);
-			if (m_Rotation == rotation)
-				return;
-		}
-		{
-			std::unique_lock lock(m_Mutex);
-			m_Rotation = rotation;
-			m_RotationDirty = true;
-		}
+		if (m_Rotation == rotation)
+			return;
+
+		m_Rotation = rotation;
+		m_TransformationDirty = true;
+		m_WorldDirty = true;
 	}
 
 	void Transform::SetRotation(const Transform* transform)
@@ -96,16 +98,12 @@ namespace Ares::ECS::Components {
 
 	void Transform::SetScale(const glm::vec3& scale)
 	{
-		{
-			std::shared_lock lock(m_Mutex);
-			if (m_Scale == scale)
-				return;
-		}
-		{
-			std::unique_lock lock(m_Mutex);
-			m_Scale = scale;
-			m_ScaleDirty = true;
-		}
+		if (m_Scale == scale)
+			return;
+
+		m_Scale = scale;
+		m_TransformationDirty = true;
+		m_WorldDirty = true;
 	}
 
 	void Transform::SetScale(const Transform* transform)
@@ -113,47 +111,24 @@ namespace Ares::ECS::Components {
 		SetScale(transform->GetScale());
 	}
 
-	void Transform::CalculateTranslationMatrix()
-	{
-		if (m_TranslationDirty.exchange(false))
-		{
-			std::unique_lock lock(m_Mutex);
-			m_TranslationMatrix = glm::translate(glm::mat4(1.0f), m_Position);
-			m_TransformationDirty = true;
-		}
-	}
-
-	void Transform::CalculateRotationMatrix()
-	{
-		if (m_RotationDirty.exchange(false))
-		{
-			std::unique_lock lock(m_Mutex);
-			m_RotationMatrix = glm::mat4_cast(m_Rotation);
-			m_TransformationDirty = true;
-		}
-	}
-
-	void Transform::CalculateScaleMatrix()
+	void Transform::CalculateTransformationMatrix()
 	{
-		if (m_ScaleDirty.exchange(false))
+		if (m_TransformationDirty)
 		{
-			std::unique_lock lock(m_Mutex);
-			m_ScaleMatrix = glm::scale(glm::mat4(1.0f), m_Scale);
-			m_TransformationDirty = true;
+			m_TransformationDirty = false;
+			m_TransformationMatrix = ComposeMatrix();
 		}
 	}
 
-	void Transform::CalculateTransformationMatrix()
+	glm::mat4 Transform::ComposeMatrix() const
 	{
-		CalculateTranslationMatrix();
-		CalculateRotationMatrix();
-		CalculateScaleMatrix();
-
-		if (m_TransformationDirty.exchange(false))
-		{
-			std::unique_lock lock(m_Mutex);
-			m_TransformationMatrix = m_TranslationMatrix * m_RotationMatrix * m_ScaleMatrix;
-		}
+		// Translation * Rotation * Scale, composed directly
+		glm::mat4 matrix = glm::mat4_cast(m_Rotation);
+		matrix[0] *= m_Scale.x;
+		matrix[1] *= m_Scale.y;
+		matrix[2] *= m_Scale.z;
+		matrix[3] = glm::vec4(m_Position, 1.0f);
+		return matrix;
 	}
 
 }
\ No newline at end of file
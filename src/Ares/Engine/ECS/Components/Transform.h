@@ -5,6 +5,12 @@
 
 #include "Engine/ECS/Core/Component.h"
 
+namespace Ares::ECS::Systems {
+
+	class TransformSystem;
+
+}
+
 namespace Ares::ECS::Components {
 
 	class Transform : public Component
@@ -13,7 +19,13 @@ namespace Ares::ECS::Components {
 		Transform();
 
 		// Getters
+		// Local matrix (relative to the parent, if there is one)
 		glm::mat4 GetTransformationMatrix();
+		// World matrix. Always current for roots. Children get theirs from the last TransformSystem
+		// update, so a write has to go through a non-const GetComponent (which marks the chunk
+		// changed) before the system runs in the frame that should see it
+		glm::mat4 GetWorldMatrix() const;
+		bool HasParent() const;
 		glm::vec3 GetPosition() const;
 		glm::quat GetRotation() const;
 		glm::vec3 GetScale() const;
@@ -29,25 +41,24 @@ namespace Ares::ECS::Components {
 		void SetScale(const Transform* transform);
 
 	private:
-		void CalculateTranslationMatrix();
-		void CalculateRotationMatrix();
-		void CalculateScaleMatrix();
 		void CalculateTransformationMatrix();
+		glm::mat4 ComposeMatrix() const;
 
 	private:
-		mutable std::shared_mutex m_Mutex;
 		glm::vec3 m_Position;
 		glm::quat m_Rotation;
 		glm::vec3 m_Scale;
 
-		glm::mat4 m_TranslationMatrix;
-		glm::mat4 m_RotationMatrix;
-		glm::mat4 m_ScaleMatrix;
 		glm::mat4 m_TransformationMatrix;
-		std::atomic<bool> m_TranslationDirty;
-		std::atomic<bool> m_RotationDirty;
-		std::atomic<bool> m_ScaleDirty;
-		std::atomic<bool> m_TransformationDirty;
+		glm::mat4 m_WorldMatrix;
+		bool m_TransformationDirty;
+		bool m_WorldDirty;
+		bool m_HasParent;
+
+		// Computes the local matrices in batches and propagates world matrices
+		friend class Systems::TransformSystem;
 	};
 
+	static_assert(std::is_trivially_copyable_v<Transform>, "Transform must be trivially copyable!");
+
 }
\ No newline at end of file
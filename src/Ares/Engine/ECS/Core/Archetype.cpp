@@ -0,0 +1,197 @@
+#include <arespch.h>
+#include "Engine/ECS/Core/Archetype.h"
+
+namespace Ares::ECS {
+
+	Archetype::Archetype(std::vector<const ComponentInfo*> components)
+		: m_Components(std::move(components))
+	{
+		std::sort(m_Components.begin(), m_Components.end(), [](const ComponentInfo* a, const ComponentInfo* b) {
+			return a->Type < b->Type;
+		});
+
+		m_Signature.reserve(m_Components.size());
+		for (const ComponentInfo* info : m_Components)
+			m_Signature.push_back(info->Type);
+
+		// Direct column lookup, the signature is sorted so the last id is the largest
+		if (!m_Signature.empty())
+			m_ColumnLookup.resize(m_Signature.back() + 1, -1);
+		for (size_t column = 0; column < m_Signature.size(); column++)
+			m_ColumnLookup[m_Signature[column]] = static_cast<int32_t>(column);
+
+		CalculateChunkLayout();
+	}
+
+	Archetype::~Archetype()
+	{
+		for (uint32_t row = 0; row < m_EntityCount; row++)
+			DestroyRow(row);
+
+		for (uint8_t* chunk : m_Chunks)
+			FreeChunk(chunk);
+		m_Chunks.clear();
+	}
+
+	size_t Archetype::GetChunkEntityCount(const size_t chunk) const
+	{
+		const size_t firstRow = chunk * m_ChunkCapacity;
+		if (firstRow >= m_EntityCount)
+			return 0;
+		return std::min(m_ChunkCapacity, m_EntityCount - firstRow);
+	}
+
+	uint32_t* Archetype::GetEntities(const size_t chunk) const
+	{
+		return reinterpret_cast<uint32_t*>(m_Chunks[chunk]);
+	}
+
+	uint8_t* Archetype::GetColumn(const size_t chunk, const size_t column) const
+	{
+		return m_Chunks[chunk] + m_ColumnOffsets[column];
+	}
+
+	void* Archetype::GetComponent(const uint32_t row, const size_t column) const
+	{
+		const size_t chunk = row / m_ChunkCapacity;
+		const size_t index = row % m_ChunkCapacity;
+		return GetColumn(chunk, column) + index * m_Components[column]->Size;
+	}
+
+	uint32_t Archetype::GetEntity(const uint32_t row) const
+	{
+		return GetEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity];
+	}
+
+	uint32_t Archetype::PushEntity(const uint32_t entityId, const uint32_t changeTick)
+	{
+		const uint32_t row = static_cast<uint32_t>(m_EntityCount);
+		if (row / m_ChunkCapacity >= m_Chunks.size())
+		{
+			m_Chunks.push_back(AllocateChunk());
+			m_ChangedVersions.resize(m_Chunks.size() * m_Components.size());
+			m_AddedVersions.resize(m_Chunks.size() * m_Components.size());
+		}
+
+		GetEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity] = entityId;
+		MarkChunkChanged(row / m_ChunkCapacity, changeTick);
+		m_EntityCount++;
+		return row;
+	}
+
+	void Archetype::DestroyRow(const uint32_t row)
+	{
+		for (size_t column = 0; column < m_Components.size(); column++)
+			m_Components[column]->Destroy(GetComponent(row, column));
+	}
+
+	uint32_t Archetype::SwapRemove(const uint32_t row, const uint32_t changeTick)
+	{
+		const uint32_t lastRow = static_cast<uint32_t>(m_EntityCount - 1);
+		uint32_t movedEntity = 0;
+
+		if (row != lastRow)
+		{
+			// Move the last row into the hole
+			for (size_t column = 0; column < m_Components.size(); column++)
+			{
+				void* source = GetComponent(lastRow, column);
+				m_Components[column]->MoveConstruct(GetComponent(row, column), source);
+				m_Components[column]->Destroy(source);
+			}
+			movedEntity = GetEntity(lastRow);
+			GetEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity] = movedEntity;
+			MarkChunkChanged(row / m_ChunkCapacity, changeTick);
+		}
+
+		m_EntityCount--;
+
+		// Release the last chunk once it becomes empty
+		if (m_EntityCount <= (m_Chunks.size() - 1) * m_ChunkCapacity)
+		{
+			FreeChunk(m_Chunks.back());
+			m_Chunks.pop_back();
+			m_ChangedVersions.resize(m_Chunks.size() * m_Components.size());
+			m_AddedVersions.resize(m_Chunks.size() * m_Components.size());
+		}
+
+		return movedEntity;
+	}
+
+	void Archetype::MarkAdded(const uint32_t row, const size_t column, const uint32_t changeTick)
+	{
+		const size_t chunk = row / m_ChunkCapacity;
+		m_AddedVersions[chunk * m_Components.size() + column] = changeTick;
+		m_ChangedVersions[chunk * m_Components.size() + column] = changeTick;
+	}
+
+	void Archetype::MarkChunkChanged(const size_t chunk, const uint32_t changeTick)
+	{
+		const size_t first = chunk * m_Components.size();
+		std::fill(m_ChangedVersions.begin() + first, m_ChangedVersions.begin() + first + m_Components.size(), changeTick);
+	}
+
+	Archetype* Archetype::GetAddEdge(const ComponentTypeID type) const
+	{
+		return type < m_AddEdges.size() ? m_AddEdges[type] : nullptr;
+	}
+
+	Archetype* Archetype::GetRemoveEdge(const ComponentTypeID type) const
+	{
+		return type < m_RemoveEdges.size() ? m_RemoveEdges[type] : nullptr;
+	}
+
+	void Archetype::SetAddEdge(const ComponentTypeID type, Archetype* archetype)
+	{
+		if (type >= m_AddEdges.size())
+			m_AddEdges.resize(type + 1, nullptr);
+		m_AddEdges[type] = archetype;
+	}
+
+	void Archetype::SetRemoveEdge(const ComponentTypeID type, Archetype* archetype)
+	{
+		if (type >= m_RemoveEdges.size())
+			m_RemoveEdges.resize(type + 1, nullptr);
+		m_RemoveEdges[type] = archetype;
+	}
+
+	void Archetype::CalculateChunkLayout()
+	{
+		size_t rowSize = sizeof(uint32_t);
+		for (const ComponentInfo* info : m_Components)
+			rowSize += info->Size;
+
+		// Start from the ideal capacity and shrink until the aligned columns fit
+		size_t capacity = std::max<size_t>(ChunkSize / rowSize, 1);
+		while (true)
+		{
+			m_ColumnOffsets.clear();
+			size_t offset = capacity * sizeof(uint32_t);
+			for (const ComponentInfo* info : m_Components)
+			{
+				offset = (offset + info->Alignment - 1) & ~(info->Alignment - 1);
+				m_ColumnOffsets.push_back(offset);
+				offset += capacity * info->Size;
+			}
+
+			if (offset <= ChunkSize || capacity == 1)
+			{
+				m_ChunkCapacity = capacity;
+				m_ChunkBytes = std::max(offset, ChunkSize);
+				break;
+			}
+			capacity--;
+		}
+	}
+
+	uint8_t* Archetype::AllocateChunk()
+	{
+		return static_cast<uint8_t*>(::operator new(m_ChunkBytes, std::align_val_t(ChunkAlignment)));
+	}
+
+	void Archetype::FreeChunk(uint8_t* chunk)
+	{
+		::operator delete(chunk, std::align_val_t(ChunkAlignment));
+	}
+
+}
\ No newline at end of file
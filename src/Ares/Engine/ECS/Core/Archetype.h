@@ -0,0 +1,93 @@
+#pragma once
+#include "Engine/ECS/Core/ComponentInfo.h"
+
+namespace Ares::ECS {
+
+	// Storage for every entity that shares the exact same set of component types.
+	// Entities are packed into fixed-size chunks, and each chunk holds one tightly
+	// packed array per component type (plus the array of entity ids).
+	//
+	// Rows are addressed globally (row = chunk * capacity + index) and are always
+	// kept dense: removing a row moves the last row of the archetype into the hole.
+	//
+	// Every chunk also keeps two versions per component column: the change tick of the last
+	// write (or of a row moving into the chunk) and the change tick of the last time the
+	// component was added. Queries compare them against a system's last run to skip chunks.
+	class Archetype
+	{
+	public:
+		static constexpr size_t ChunkSize = 16 * 1024;
+		static constexpr size_t ChunkAlignment = 64;
+
+	public:
+		Archetype(std::vector<const ComponentInfo*> components);
+		~Archetype();
+
+		Archetype(const Archetype&) = delete;
+		Archetype& operator=(const Archetype&) = delete;
+
+		// Signature
+		inline const std::vector<ComponentTypeID>& GetSignature() const { return m_Signature; }
+		inline const std::vector<const ComponentInfo*>& GetComponents() const { return m_Components; }
+		inline int32_t GetColumnIndex(const ComponentTypeID type) const { return type < m_ColumnLookup.size() ? m_ColumnLookup[type] : -1; }
+		inline bool HasComponent(const ComponentTypeID type) const { return GetColumnIndex(type) >= 0; }
+
+		// Sizes
+		inline size_t GetEntityCount() const { return m_EntityCount; }
+		inline size_t GetChunkCount() const { return m_Chunks.size(); }
+		inline size_t GetChunkCapacity() const { return m_ChunkCapacity; }
+		size_t GetChunkEntityCount(const size_t chunk) const;
+
+		// Raw chunk access (used for iteration)
+		uint32_t* GetEntities(const size_t chunk) const;
+		uint8_t* GetColumn(const size_t chunk, const size_t column) const;
+
+		// Row access
+		void* GetComponent(const uint32_t row, const size_t column) const;
+		uint32_t GetEntity(const uint32_t row) const;
+
+		// Row management
+		// Appends an entity and returns its row, component memory is left uninitialized
+		uint32_t PushEntity(const uint32_t entityId, const uint32_t changeTick);
+		// Destroys every component in a row
+		void DestroyRow(const uint32_t row);
+		// Fills the (already destroyed or moved-from) row with the last row and shrinks the archetype.
+		// Returns the id of the entity that now occupies the row, or 0 if the row was the last one.
+		uint32_t SwapRemove(const uint32_t row, const uint32_t changeTick);
+
+		// Change tracking
+		inline uint32_t GetChangedVersion(const size_t chunk, const size_t column) const { return m_ChangedVersions[chunk * m_Components.size() + column]; }
+		inline uint32_t GetAddedVersion(const size_t chunk, const size_t column) const { return m_AddedVersions[chunk * m_Components.size() + column]; }
+		inline void MarkChanged(const size_t chunk, const size_t column, const uint32_t changeTick) { m_ChangedVersions[chunk * m_Components.size() + column] = changeTick; }
+		void MarkAdded(const uint32_t row, const size_t column, const uint32_t changeTick);
+		void MarkChunkChanged(const size_t chunk, const uint32_t changeTick);
+
+		// Cached archetype graph edges
+		Archetype* GetAddEdge(const ComponentTypeID type) const;
+		Archetype* GetRemoveEdge(const ComponentTypeID type) const;
+		void SetAddEdge(const ComponentTypeID type, Archetype* archetype);
+		void SetRemoveEdge(const ComponentTypeID type, Archetype* archetype);
+
+	private:
+		void CalculateChunkLayout();
+		uint8_t* AllocateChunk();
+		void FreeChunk(uint8_t* chunk);
+
+	private:
+		std::vector<const ComponentInfo*> m_Components;
+		std::vector<ComponentTypeID> m_Signature;
+		std::vector<size_t> m_ColumnOffsets;
+		std::vector<uint8_t*> m_Chunks;
+		std::vector<uint32_t> m_ChangedVersions;
+		std::vector<uint32_t> m_AddedVersions;
+		size_t m_ChunkCapacity = 0;
+		size_t m_ChunkBytes = 0;
+		size_t m_EntityCount = 0;
+
+		// Indexed by component type id
+		std::vector<int32_t> m_ColumnLookup;
+		std::vector<Archetype*> m_AddEdges;
+		std::vector<Archetype*> m_RemoveEdges;
+	};
+
+}
\ No newline at end of file
@@ -2,9 +2,10 @@
 
 namespace Ares::ECS {
 
+	// Tag base for components. Components are plain data without locks: access is
+	// synchronized by the system scheduler's declared reads/writes and by frame phases.
 	struct Component
 	{
-		virtual ~Component() = default;
 	};
 
 }
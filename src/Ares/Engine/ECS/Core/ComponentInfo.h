@@ -0,0 +1,70 @@
+#pragma once
+#include "Engine/Core/TypeID.h"
+#include "Engine/ECS/Core/Component.h"
+
+namespace Ares::ECS {
+
+	// Dense id of a component type (see TypeID), small enough to index arrays
+	using ComponentTypeID = uint32_t;
+
+	template <typename ECSComponent>
+	inline ComponentTypeID GetComponentTypeID()
+	{
+		return TypeID<Component>::Get<ECSComponent>();
+	}
+
+	// Type-erased description of a component type, used by the archetype storage
+	// to construct, copy, move and destroy components that live in raw chunk memory
+	struct ComponentInfo
+	{
+		using MoveConstructFn = void(*)(void* destination, void* source);
+		using CopyConstructFn = void(*)(void* destination, const void* source);
+		using DestroyFn = void(*)(void* component);
+
+		ComponentTypeID Type;
+		size_t Size;
+		size_t Alignment;
+		// Trivially copyable components can be copied with memcpy
+		bool TriviallyCopyable;
+		MoveConstructFn MoveConstruct;
+		// nullptr for components that can't be copied
+		CopyConstructFn CopyConstruct;
+		DestroyFn Destroy;
+
+		template <typename ECSComponent>
+		static const ComponentInfo& Get();
+	};
+
+	template <typename ECSComponent>
+	inline const ComponentInfo& ComponentInfo::Get()
+	{
+		static_assert(std::is_move_constructible_v<ECSComponent>, "Components must be move constructible!");
+
+		static const ComponentInfo s_Info{
+			GetComponentTypeID<ECSComponent>(),
+			sizeof(ECSComponent),
+			alignof(ECSComponent),
+			std::is_trivially_copyable_v<ECSComponent>,
+			[](void* destination, void* source) {
+				new (destination) ECSComponent(std::move(*static_cast<ECSComponent*>(source)));
+			},
+			[]() -> CopyConstructFn {
+				if constexpr (std::is_copy_constructible_v<ECSComponent>)
+				{
+					return [](void* destination, const void* source) {
+						new (destination) ECSComponent(*static_cast<const ECSComponent*>(source));
+					};
+				}
+				else
+				{
+					return nullptr;
+				}
+			}(),
+			[](void* component) {
+				static_cast<ECSComponent*>(component)->~ECSComponent();
+			}
+		};
+		return s_Info;
+	}
+
+}
\ No newline at end of file
@@ -44,7 +44,7 @@ namespace Ares::ECS {
 	const bool Entity::IsValid() const
 	{
 		std::shared_lock<std::shared_mutex> lock(m_Mutex);
-		return m_Manager != nullptr;
+		return m_Manager != nullptr && m_Manager->IsAlive(m_ID);
 	}
 
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <arespch.h>
+#include "Engine/ECS/Core/EntityCommandBuffer.h"
+
+#include "Engine/ECS/Core/EntityManager.h"
+
+namespace Ares::ECS {
+
+	EntityCommandBuffer::~EntityCommandBuffer()
+	{
+		Clear();
+		for (Block& block : m_Blocks)
+			::operator delete(block.Data, std::align_val_t(BlockAlignment));
+		m_Blocks.clear();
+	}
+
+	uint32_t EntityCommandBuffer::CreateEntity()
+	{
+		AR_CORE_ASSERT(m_PendingCount < EntityID::IndexMask, "Too many pending entities in command buffer!");
+		const uint32_t pendingId = EntityID::Create(++m_PendingCount, 0);
+		m_Commands.push_back({ CommandType::Create, pendingId, nullptr, nullptr });
+		return pendingId;
+	}
+
+	void EntityCommandBuffer::DestroyEntity(const uint32_t entityId)
+	{
+		m_Commands.push_back({ CommandType::Destroy, entityId, nullptr, nullptr });
+	}
+
+	void EntityCommandBuffer::Clear()
+	{
+		for (Command& command : m_Commands)
+		{
+			if (command.Type == CommandType::AddComponent)
+				command.Component->Destroy(command.Data);
+		}
+		Reset();
+	}
+
+	void EntityCommandBuffer::Playback(EntityManager& manager, std::vector<uint32_t>& destroyedEntities)
+	{
+		// Real ids of the entities created by this buffer, indexed by pending index
+		std::vector<uint32_t> createdEntities(m_PendingCount + 1, EntityID::Invalid);
+		auto resolve = [&createdEntities](const uint32_t entityId) {
+			return IsPending(entityId) ? createdEntities[EntityID::GetIndex(entityId)] : entityId;
+		};
+
+		for (Command& command : m_Commands)
+		{
+			switch (command.Type)
+			{
+			case CommandType::Create:
+				createdEntities[EntityID::GetIndex(command.EntityId)] = manager.CreateEntityRecord();
+				break;
+			case CommandType::Destroy:
+			{
+				const uint32_t entityId = resolve(command.EntityId);
+				if (manager.DestroyEntityRecord(entityId))
+					destroyedEntities.push_back(entityId);
+				break;
+			}
+			case CommandType::AddComponent:
+			{
+				void* component = manager.EmplaceComponent(resolve(command.EntityId), *command.Component);
+				if (component != nullptr)
+					command.Component->MoveConstruct(component, command.Data);
+				else
+					AR_CORE_WARN("Tried to add a component to an entity that does not exist!");
+				command.Component->Destroy(command.Data);
+				break;
+			}
+			case CommandType::RemoveComponent:
+				manager.EraseComponent(resolve(command.EntityId), *command.Component);
+				break;
+			}
+		}
+
+		Reset();
+	}
+
+	void* EntityCommandBuffer::Allocate(const size_t size, const size_t alignment)
+	{
+		AR_CORE_ASSERT(alignment <= BlockAlignment, "Component alignment is too large for command buffer!");
+
+		if (m_BlockIndex < m_Blocks.size())
+		{
+			const size_t offset = (m_BlockOffset + alignment - 1) & ~(alignment - 1);
+			if (offset + size <= m_Blocks[m_BlockIndex].Size)
+			{
+				m_BlockOffset = offset + size;
+				return m_Blocks[m_BlockIndex].Data + offset;
+			}
+			m_BlockIndex++;
+		}
+
+		// Move on to the next block, allocating it if there isn't one large enough
+		if (m_BlockIndex == m_Blocks.size() || m_Blocks[m_BlockIndex].Size < size)
+		{
+			const size_t blockSize = std::max(BlockSize, size);
+			uint8_t* data = static_cast<uint8_t*>(::operator new(blockSize, std::align_val_t(BlockAlignment)));
+			m_Blocks.insert(m_Blocks.begin() + m_BlockIndex, { data, blockSize });
+		}
+
+		m_BlockOffset = size;
+		return m_Blocks[m_BlockIndex].Data;
+	}
+
+	void EntityCommandBuffer::Reset()
+	{
+		m_Commands.clear();
+		m_BlockIndex = 0;
+		m_BlockOffset = 0;
+		m_PendingCount = 0;
+	}
+
+}
\ No newline at end of file
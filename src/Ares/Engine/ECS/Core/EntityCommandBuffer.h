@@ -0,0 +1,99 @@
+#pragma once
+#include "Engine/ECS/Core/ComponentInfo.h"
+#include "Engine/ECS/Core/EntityID.h"
+
+namespace Ares::ECS {
+
+	class EntityManager;
+
+	// Records structural changes (creating & destroying entities, adding & removing components)
+	// so they can be made while systems are iterating. Each thread records into its own buffer
+	// (see EntityManager::GetCommandBuffer) and every buffer is played back at one sync point per frame.
+	//
+	// Entities created through a command buffer get a pending id (generation 0) that is only
+	// valid for later commands in the same buffer, until the buffer is played back.
+	class EntityCommandBuffer
+	{
+	public:
+		static constexpr size_t BlockSize = 16 * 1024;
+		static constexpr size_t BlockAlignment = 64;
+
+	public:
+		EntityCommandBuffer() = default;
+		~EntityCommandBuffer();
+
+		EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+		EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+		// Record commands
+		uint32_t CreateEntity();
+		void DestroyEntity(const uint32_t entityId);
+		template <typename ECSComponent, typename... Args>
+		void AddComponent(const uint32_t entityId, Args&&... args);
+		template <typename ECSComponent>
+		void RemoveComponent(const uint32_t entityId);
+
+		// Drop every recorded command without applying it
+		void Clear();
+
+		inline bool IsEmpty() const { return m_Commands.empty(); }
+		inline size_t GetCommandCount() const { return m_Commands.size(); }
+
+		static inline bool IsPending(const uint32_t entityId) { return entityId != EntityID::Invalid && EntityID::GetGeneration(entityId) == 0; }
+
+	private:
+		enum class CommandType : uint8_t
+		{
+			Create,
+			Destroy,
+			AddComponent,
+			RemoveComponent
+		};
+
+		struct Command
+		{
+			CommandType Type;
+			uint32_t EntityId;
+			const ComponentInfo* Component;
+			void* Data;
+		};
+
+		struct Block
+		{
+			uint8_t* Data;
+			size_t Size;
+		};
+
+		// Apply every command (expects the entity manager's component mutex to be held)
+		void Playback(EntityManager& manager, std::vector<uint32_t>& destroyedEntities);
+
+		// Linear allocation of component data, blocks are kept and reused after playback
+		void* Allocate(const size_t size, const size_t alignment);
+		void Reset();
+
+	private:
+		std::vector<Command> m_Commands;
+		std::vector<Block> m_Blocks;
+		size_t m_BlockIndex = 0;
+		size_t m_BlockOffset = 0;
+		uint32_t m_PendingCount = 0;
+
+		friend class EntityManager;
+	};
+
+	template <typename ECSComponent, typename... Args>
+	inline void EntityCommandBuffer::AddComponent(const uint32_t entityId, Args&&... args)
+	{
+		const ComponentInfo& info = ComponentInfo::Get<ECSComponent>();
+		void* data = Allocate(info.Size, info.Alignment);
+		new (data) ECSComponent(std::forward<Args>(args)...);
+		m_Commands.push_back({ CommandType::AddComponent, entityId, &info, data });
+	}
+
+	template <typename ECSComponent>
+	inline void EntityCommandBuffer::RemoveComponent(const uint32_t entityId)
+	{
+		m_Commands.push_back({ CommandType::RemoveComponent, entityId, &ComponentInfo::Get<ECSComponent>(), nullptr });
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+namespace Ares::ECS::EntityID {
+
+	// Entity ids are 32-bit handles: the low 20 bits index the entity slot, the high
+	// 12 bits hold the slot generation. A slot's generation is bumped every time its
+	// entity is destroyed, so old handles to a recycled slot no longer match.
+	// Generations of live entities start at 1, which keeps 0 free as the invalid id.
+	// Generations never wrap: a slot whose generation reaches MaxGeneration is retired.
+	constexpr uint32_t IndexBits = 20;
+	constexpr uint32_t GenerationBits = 12;
+	constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+	constexpr uint32_t GenerationMask = (1u << GenerationBits) - 1;
+	constexpr uint32_t MaxEntities = IndexMask + 1;
+	constexpr uint32_t MaxGeneration = GenerationMask;
+
+	constexpr uint32_t Invalid = 0;
+
+	constexpr uint32_t Create(const uint32_t index, const uint32_t generation)
+	{
+		return ((generation & GenerationMask) << IndexBits) | (index & IndexMask);
+	}
+
+	constexpr uint32_t GetIndex(const uint32_t id)
+	{
+		return id & IndexMask;
+	}
+
+	constexpr uint32_t GetGeneration(const uint32_t id)
+	{
+		return (id >> IndexBits) & GenerationMask;
+	}
+
+}
\ No newline at end of file
@@ -3,17 +3,78 @@
 
 namespace Ares::ECS {
 
+	EntityManager::EntityManager()
+	{
+		m_RootArchetype = GetOrCreateArchetype({});
+	}
+
+	EntityManager::~EntityManager()
+	{
+		std::unique_lock lock(m_ComponentMutex);
+		m_EntityRecords.clear();
+		m_Queries.clear();
+		m_ArchetypeMap.clear();
+		m_Archetypes.clear();
+	}
+
 	Entity EntityManager::CreateEntity()
 	{
-		std::unique_lock lock(m_IdMutex);
-		uint32_t id = m_NextEntityID++;
-		return Entity(id, this);
+		std::unique_lock lock(m_ComponentMutex);
+		return Entity(CreateEntityRecord(), this);
 	}
 
 	void EntityManager::DestroyEntity(Entity& entity)
+	{
+		const uint32_t entityId = entity.GetID();
+		{
+			std::unique_lock lock(m_ComponentMutex);
+			if (!DestroyEntityRecord(entityId))
+				return;
+		}
+		ClearEntityName(entityId);
+	}
+
+	std::vector<uint32_t> EntityManager::Instantiate(const Prefab& prefab, const size_t count)
+	{
+		return InstantiatePrefab(prefab, count, nullptr, nullptr);
+	}
+
+	EntityCommandBuffer& EntityManager::GetCommandBuffer()
+	{
+		std::unique_lock lock(m_CommandBufferMutex);
+		Scope<EntityCommandBuffer>& commandBuffer = m_CommandBuffers[std::this_thread::get_id()];
+		if (commandBuffer == nullptr)
+			commandBuffer = CreateScope<EntityCommandBuffer>();
+		return *commandBuffer;
+	}
+
+	uint32_t EntityManager::AdvanceChangeTick()
 	{
 		std::unique_lock lock(m_ComponentMutex);
-		m_Components.erase(entity.GetID());
+		return ++m_ChangeTick;
+	}
+
+	void EntityManager::PlaybackCommandBuffers()
+	{
+		std::unique_lock bufferLock(m_CommandBufferMutex);
+		const bool empty = std::all_of(m_CommandBuffers.begin(), m_CommandBuffers.end(),
+			[](const auto& entry) { return entry.second->IsEmpty(); });
+		if (empty)
+			return;
+
+		// Structural changes get their own tick so every system sees them on its next update
+		AdvanceChangeTick();
+
+		std::vector<uint32_t> destroyedEntities;
+		{
+			// Apply every recorded change under a single lock
+			std::unique_lock componentLock(m_ComponentMutex);
+			for (auto& [threadId, commandBuffer] : m_CommandBuffers)
+				commandBuffer->Playback(*this, destroyedEntities);
+		}
+
+		for (const uint32_t entityId : destroyedEntities)
+			ClearEntityName(entityId);
 	}
 
 	void EntityManager::SetEntityName(Entity& entity, const std::string& name)
@@ -25,8 +86,7 @@ namespace Ares::ECS {
 
 	Entity EntityManager::GetEntity(const uint32_t& id)
 	{
-		std::shared_lock lock(m_IdMutex);
-		if (id < m_NextEntityID)
+		if (IsAlive(id))
 		{
 			return Entity(id, this);
 		}
@@ -56,10 +116,365 @@ namespace Ares::ECS {
 		return m_EntityNameMap[entityId];
 	}
 
-	const std::unordered_map<uint32_t, std::unordered_map<std::type_index, Scope<Component>>>& EntityManager::GetEntityComponents()
+	bool EntityManager::IsAlive(const uint32_t entityId)
+	{
+		std::shared_lock<std::shared_mutex> lock(m_ComponentMutex);
+		return FindRecord(entityId) != nullptr;
+	}
+
+	std::vector<uint32_t> EntityManager::GetEntities()
+	{
+		std::shared_lock<std::shared_mutex> lock(m_ComponentMutex);
+		std::vector<uint32_t> result;
+		result.reserve(m_EntityRecords.size() - m_FreeIndices.size());
+		for (uint32_t index = 0; index < m_EntityRecords.size(); index++)
+		{
+			const EntityRecord& record = m_EntityRecords[index];
+			if (record.Storage != nullptr)
+				result.push_back(EntityID::Create(index, record.Generation));
+		}
+		return result;
+	}
+
+	std::vector<ComponentTypeID> EntityManager::GetComponentTypes(const uint32_t entityId)
+	{
+		std::shared_lock<std::shared_mutex> lock(m_ComponentMutex);
+		const EntityRecord* record = FindRecord(entityId);
+		if (record != nullptr)
+			return record->Storage->GetSignature();
+		return {};
+	}
+
+	const std::vector<Scope<Archetype>>& EntityManager::GetArchetypes() const
+	{
+		return m_Archetypes;
+	}
+
+	EntityManager::ComponentLocation EntityManager::GetComponentLocation(const uint32_t entityId, const ComponentTypeID type)
+	{
+		std::shared_lock<std::shared_mutex> lock(m_ComponentMutex);
+		const EntityRecord* record = FindRecord(entityId);
+		if (record == nullptr || !record->Storage->HasComponent(type))
+			return {};
+		return { record->Storage, record->Row, record->Storage->GetColumnIndex(type) };
+	}
+
+	uint32_t EntityManager::CreateEntityRecord(Archetype* storage)
+	{
+		// Reuse the oldest free slot once enough are queued (or when no new slot is left)
+		uint32_t index = 0;
+		const bool canGrow = m_EntityRecords.size() < EntityID::MaxEntities;
+		if (!m_FreeIndices.empty() && (m_FreeIndices.size() >= MinFreeIndices || !canGrow))
+		{
+			index = m_FreeIndices.front();
+			m_FreeIndices.pop_front();
+		}
+		else if (canGrow)
+		{
+			index = static_cast<uint32_t>(m_EntityRecords.size());
+			m_EntityRecords.emplace_back();
+		}
+		else
+		{
+			AR_CORE_ERROR("Can't create entity, all {} entity slots are in use!", EntityID::MaxEntities);
+			return EntityID::Invalid;
+		}
+
+		m_StructureVersion.fetch_add(1, std::memory_order_release);
+		EntityRecord& record = m_EntityRecords[index];
+		const uint32_t id = EntityID::Create(index, record.Generation);
+		record.Storage = storage != nullptr ? storage : m_RootArchetype;
+		record.Row = record.Storage->PushEntity(id, m_ChangeTick);
+		return id;
+	}
+
+	size_t EntityManager::GetAvailableRecordCount() const
+	{
+		return m_FreeIndices.size() + (EntityID::MaxEntities - m_EntityRecords.size());
+	}
+
+	std::vector<uint32_t> EntityManager::InstantiatePrefab(const Prefab& prefab, const size_t count, const ComponentInfo* overrideComponent, const void* values)
+	{
+		std::vector<uint32_t> entityIds(count);
+		if (count == 0)
+			return entityIds;
+
+		std::vector<const ComponentInfo*> components = prefab.GetComponents();
+		if (overrideComponent != nullptr && prefab.GetComponentData(overrideComponent->Type) == nullptr)
+			components.push_back(overrideComponent);
+
+		std::unique_lock lock(m_ComponentMutex);
+		if (count > GetAvailableRecordCount())
+		{
+			AR_CORE_ERROR("Can't instantiate {} entities, only {} entity slots are left!", count, GetAvailableRecordCount());
+			return {};
+		}
+
+		Archetype* archetype = GetOrCreateArchetype(components);
+		if (count > m_FreeIndices.size())
+			m_EntityRecords.reserve(m_EntityRecords.size() + count - m_FreeIndices.size());
+
+		const uint32_t firstRow = static_cast<uint32_t>(archetype->GetEntityCount());
+		for (size_t i = 0; i < count; i++)
+			entityIds[i] = CreateEntityRecord(archetype);
+
+		// The new rows are contiguous, so fill each column one chunk at a time
+		const size_t capacity = archetype->GetChunkCapacity();
+		for (size_t column = 0; column < archetype->GetComponents().size(); column++)
+		{
+			const ComponentInfo& info = *archetype->GetComponents()[column];
+			const bool overridden = overrideComponent != nullptr && info.Type == overrideComponent->Type;
+			const uint8_t* source = static_cast<const uint8_t*>(overridden ? values : prefab.GetComponentData(info.Type));
+
+			size_t instance = 0;
+			while (instance < count)
+			{
+				const uint32_t row = firstRow + static_cast<uint32_t>(instance);
+				const size_t index = row % capacity;
+				const size_t run = std::min(capacity - index, count - instance);
+				uint8_t* destination = archetype->GetColumn(row / capacity, column) + index * info.Size;
+
+				if (overridden && info.TriviallyCopyable)
+				{
+					std::memcpy(destination, source + instance * info.Size, run * info.Size);
+				}
+				else if (overridden)
+				{
+					for (size_t i = 0; i < run; i++)
+						info.CopyConstruct(destination + i * info.Size, source + (instance + i) * info.Size);
+				}
+				else if (info.TriviallyCopyable)
+				{
+					// Copy the prototype once, then keep doubling the filled range
+					std::memcpy(destination, source, info.Size);
+					for (size_t filled = 1; filled < run;)
+					{
+						const size_t copied = std::min(filled, run - filled);
+						std::memcpy(destination + filled * info.Size, destination, copied * info.Size);
+						filled += copied;
+					}
+				}
+				else
+				{
+					for (size_t i = 0; i < run; i++)
+						info.CopyConstruct(destination + i * info.Size, source);
+				}
+
+				archetype->MarkAdded(row, column, m_ChangeTick);
+				instance += run;
+			}
+		}
+
+		return entityIds;
+	}
+
+	bool EntityManager::DestroyEntityRecord(const uint32_t entityId)
+	{
+		EntityRecord* record = FindRecord(entityId);
+		if (record == nullptr)
+			return false;
+
+		m_StructureVersion.fetch_add(1, std::memory_order_release);
+		Archetype* storage = record->Storage;
+		const uint32_t row = record->Row;
+		storage->DestroyRow(row);
+		const uint32_t movedEntity = storage->SwapRemove(row, m_ChangeTick);
+		if (movedEntity)
+			m_EntityRecords[EntityID::GetIndex(movedEntity)].Row = row;
+
+		// Free the slot, bumping the generation invalidates every existing handle. A slot whose
+		// generation would wrap is never reused, so old handles can't match a new entity
+		record->Storage = nullptr;
+		record->Row = 0;
+		if (record->Generation < EntityID::MaxGeneration)
+		{
+			record->Generation++;
+			m_FreeIndices.push_back(EntityID::GetIndex(entityId));
+		}
+		return true;
+	}
+
+	void EntityManager::ClearEntityName(const uint32_t entityId)
+	{
+		std::unique_lock lock(m_MapMutex);
+		auto it = m_EntityNameMap.find(entityId);
+		if (it != m_EntityNameMap.end())
+		{
+			m_NameEntityMap.erase(it->second);
+			m_EntityNameMap.erase(it);
+		}
+	}
+
+	void* EntityManager::EmplaceComponent(const uint32_t entityId, const ComponentInfo& component)
+	{
+		EntityRecord* record = FindRecord(entityId);
+		if (record == nullptr)
+			return nullptr;
+
+		int32_t column = record->Storage->GetColumnIndex(component.Type);
+		if (column >= 0)
+		{
+			// Replace the existing component
+			void* existing = record->Storage->GetComponent(record->Row, column);
+			component.Destroy(existing);
+			record->Storage->MarkAdded(record->Row, column, m_ChangeTick);
+			return existing;
+		}
+
+		MoveEntity(entityId, *record, GetArchetypeWith(record->Storage, component));
+		column = record->Storage->GetColumnIndex(component.Type);
+		record->Storage->MarkAdded(record->Row, column, m_ChangeTick);
+		return record->Storage->GetComponent(record->Row, column);
+	}
+
+	void EntityManager::EraseComponent(const uint32_t entityId, const ComponentInfo& component)
+	{
+		EntityRecord* record = FindRecord(entityId);
+		if (record == nullptr || !record->Storage->HasComponent(component.Type))
+			return;
+
+		MoveEntity(entityId, *record, GetArchetypeWithout(record->Storage, component));
+	}
+
+	EntityManager::EntityRecord* EntityManager::FindRecord(const uint32_t entityId)
+	{
+		const uint32_t index = EntityID::GetIndex(entityId);
+		if (index >= m_EntityRecords.size())
+			return nullptr;
+
+		EntityRecord& record = m_EntityRecords[index];
+		if (record.Storage == nullptr || record.Generation != EntityID::GetGeneration(entityId))
+			return nullptr;
+		return &record;
+	}
+
+	Ref<const std::vector<Archetype*>> EntityManager::GetQueryArchetypes(const std::vector<ComponentTypeID>& signature)
+	{
+		{
+			std::shared_lock<std::shared_mutex> lock(m_ComponentMutex);
+			auto it = m_Queries.find(signature);
+			if (it != m_Queries.end())
+				return it->second->Archetypes;
+		}
+
+		std::unique_lock lock(m_ComponentMutex);
+		Scope<QueryCache>& query = m_Queries[signature];
+		if (query == nullptr)
+		{
+			// Register the query and match it against the existing archetypes once
+			query = CreateScope<QueryCache>();
+			query->Signature = signature;
+			Ref<std::vector<Archetype*>> archetypes = CreateRef<std::vector<Archetype*>>();
+			for (const Scope<Archetype>& archetype : m_Archetypes)
+			{
+				if (MatchesQuery(archetype.get(), *query))
+					archetypes->push_back(archetype.get());
+			}
+			query->Archetypes = archetypes;
+		}
+		return query->Archetypes;
+	}
+
+	bool EntityManager::MatchesQuery(const Archetype* archetype, const QueryCache& query)
+	{
+		for (const ComponentTypeID type : query.Signature)
+		{
+			if (!archetype->HasComponent(type))
+				return false;
+		}
+		return true;
+	}
+
+	Archetype* EntityManager::GetOrCreateArchetype(std::vector<const ComponentInfo*> components)
+	{
+		std::sort(components.begin(), components.end(), [](const ComponentInfo* a, const ComponentInfo* b) {
+			return a->Type < b->Type;
+		});
+
+		std::vector<ComponentTypeID> signature;
+		signature.reserve(components.size());
+		for (const ComponentInfo* info : components)
+			signature.push_back(info->Type);
+
+		auto it = m_ArchetypeMap.find(signature);
+		if (it != m_ArchetypeMap.end())
+			return it->second;
+
+		m_Archetypes.push_back(CreateScope<Archetype>(std::move(components)));
+		Archetype* archetype = m_Archetypes.back().get();
+		m_ArchetypeMap[std::move(signature)] = archetype;
+
+		// Keep registered queries up to date. Views may still iterate the old list, so it's copied
+		for (auto& [querySignature, query] : m_Queries)
+		{
+			if (!MatchesQuery(archetype, *query))
+				continue;
+
+			Ref<std::vector<Archetype*>> archetypes = CreateRef<std::vector<Archetype*>>(*query->Archetypes);
+			archetypes->push_back(archetype);
+			query->Archetypes = archetypes;
+		}
+		return archetype;
+	}
+
+	Archetype* EntityManager::GetArchetypeWith(Archetype* source, const ComponentInfo& component)
+	{
+		Archetype* destination = source->GetAddEdge(component.Type);
+		if (destination == nullptr)
+		{
+			std::vector<const ComponentInfo*> components = source->GetComponents();
+			components.push_back(&component);
+			destination = GetOrCreateArchetype(std::move(components));
+
+			source->SetAddEdge(component.Type, destination);
+			destination->SetRemoveEdge(component.Type, source);
+		}
+		return destination;
+	}
+
+	Archetype* EntityManager::GetArchetypeWithout(Archetype* source, const ComponentInfo& component)
+	{
+		Archetype* destination = source->GetRemoveEdge(component.Type);
+		if (destination == nullptr)
+		{
+			std::vector<const ComponentInfo*> components;
+			for (const ComponentInfo* info : source->GetComponents())
+			{
+				if (info->Type != component.Type)
+					components.push_back(info);
+			}
+			destination = GetOrCreateArchetype(std::move(components));
+
+			source->SetRemoveEdge(component.Type, destination);
+			destination->SetAddEdge(component.Type, source);
+		}
+		return destination;
+	}
+
+	void EntityManager::MoveEntity(const uint32_t entityId, EntityRecord& record, Archetype* destination)
 	{
-		std::shared_lock lock(m_ComponentMutex);
-		return m_Components;
+		m_StructureVersion.fetch_add(1, std::memory_order_release);
+		Archetype* source = record.Storage;
+		const uint32_t sourceRow = record.Row;
+		const uint32_t destinationRow = destination->PushEntity(entityId, m_ChangeTick);
+
+		// Move shared components across and destroy the ones the destination doesn't have
+		const std::vector<const ComponentInfo*>& components = source->GetComponents();
+		for (size_t column = 0; column < components.size(); column++)
+		{
+			void* component = source->GetComponent(sourceRow, column);
+			const int32_t destinationColumn = destination->GetColumnIndex(components[column]->Type);
+			if (destinationColumn >= 0)
+				components[column]->MoveConstruct(destination->GetComponent(destinationRow, destinationColumn), component);
+			components[column]->Destroy(component);
+		}
+
+		const uint32_t movedEntity = source->SwapRemove(sourceRow, m_ChangeTick);
+		if (movedEntity)
+			m_EntityRecords[EntityID::GetIndex(movedEntity)].Row = sourceRow;
+
+		record.Storage = destination;
+		record.Row = destinationRow;
 	}
 
 }
\ No newline at end of file
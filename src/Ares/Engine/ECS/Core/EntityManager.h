@@ -1,5 +1,11 @@
 #pragma once
+#include "Engine/ECS/Core/Archetype.h"
 #include "Engine/ECS/Core/Component.h"
+#include "Engine/ECS/Core/ComponentInfo.h"
+#include "Engine/ECS/Core/EntityCommandBuffer.h"
+#include "Engine/ECS/Core/EntityID.h"
+#include "Engine/ECS/Core/Prefab.h"
+#include "Engine/ECS/Core/View.h"
 
 namespace Ares::ECS {
 
@@ -8,19 +14,48 @@ namespace Ares::ECS {
 	class EntityManager
 	{
 	public:
-		EntityManager() = default;
+		// Freed slots wait until at least this many are queued before being reused
+		static constexpr size_t MinFreeIndices = 1024;
+
+	public:
+		EntityManager();
+		~EntityManager();
 
 		// Entity related methods
 		Entity CreateEntity();
 		void DestroyEntity(Entity& entity);
 		void SetEntityName(Entity& entity, const std::string& name);
 
+		// Returns false for ids of destroyed entities, even if their slot was recycled
+		bool IsAlive(const uint32_t entityId);
+
+		// Create count entities from a prefab in one go, straight into the archetype of the prefab's
+		// components. Returns the ids of the new entities.
+		std::vector<uint32_t> Instantiate(const Prefab& prefab, const size_t count);
+		// Same, but with the value of one component given per entity (e.g. a Transform each)
+		template <typename ECSComponent>
+		std::vector<uint32_t> Instantiate(const Prefab& prefab, const size_t count, const ECSComponent* values);
+
 		// Getter methods
 		Entity GetEntity(const uint32_t& id);
 		Entity GetEntity(const std::string& name);
 		const std::string GetEntityName(Entity& entity);
 		const std::string GetEntityName(const uint32_t& entityId);
-		const std::unordered_map<uint32_t, std::unordered_map<std::type_index, Scope<Component>>>& GetEntityComponents();
+		std::vector<uint32_t> GetEntities();
+		std::vector<ComponentTypeID> GetComponentTypes(const uint32_t entityId);
+		const std::vector<Scope<Archetype>>& GetArchetypes() const;
+
+		// Storage of an entity's component, Storage is nullptr if the entity doesn't have it
+		struct ComponentLocation
+		{
+			Archetype* Storage = nullptr;
+			uint32_t Row = 0;
+			int32_t Column = -1;
+		};
+		ComponentLocation GetComponentLocation(const uint32_t entityId, const ComponentTypeID type);
+		// Bumped whenever rows are created, destroyed or moved. Component pointers & locations cached
+		// while the version stays the same are still valid
+		inline uint64_t GetStructureVersion() const { return m_StructureVersion.load(std::memory_order_acquire); }
 
 		// Add a component to an entity
 		template <typename ECSComponent, typename... Args>
@@ -34,21 +69,98 @@ namespace Ares::ECS {
 		template <typename ECSComponent>
 		void RemoveComponent(uint32_t entityId);
 
-		// Get a component from an entity
+		// Get a component from an entity (ask for a const component to read without marking it changed)
 		template <typename ECSComponent>
 		ECSComponent* GetComponent(Entity entity);
 		template <typename ECSComponent>
 		ECSComponent* GetComponent(uint32_t entityId);
 
+		// Change tracking
+		// Every write access (non-const GetComponent or View iteration) stamps the component's chunk
+		// with the current change tick. The scheduler advances the tick before each stage.
+		inline uint32_t GetChangeTick() const { return m_ChangeTick; }
+		uint32_t AdvanceChangeTick();
+
+		// Command buffer of the calling thread, used to record structural changes while systems run
+		EntityCommandBuffer& GetCommandBuffer();
+		// Apply and clear every recorded command buffer (called by the scene after rendering)
+		void PlaybackCommandBuffers();
+
+		// Query every entity that has all of the given components.
+		// The first query for a component set registers it, after that the list of
+		// matching archetypes is kept up to date as new archetypes are created.
+		// Components that are only read should be queried as const, so they aren't marked changed.
+		template <typename... ECSComponents>
+		View<ECSComponents...> Query();
+
+	private:
+		// Entity slot, holding the location of the entity inside the archetype storage.
+		// Slots of destroyed entities have no storage and wait in the free queue, unless their
+		// generation ran out, then they're retired for good.
+		struct EntityRecord
+		{
+			Archetype* Storage = nullptr;
+			uint32_t Row = 0;
+			uint32_t Generation = 1;
+		};
+
+		// Entity & component changes (expect m_ComponentMutex to be held)
+		// Returns the record of a live entity or nullptr
+		EntityRecord* FindRecord(const uint32_t entityId);
+		// Creates the entity in the root archetype, or straight in storage (components left uninitialized).
+		// Returns EntityID::Invalid when every slot is in use
+		uint32_t CreateEntityRecord(Archetype* storage = nullptr);
+		// Number of entities that can still be created
+		size_t GetAvailableRecordCount() const;
+		bool DestroyEntityRecord(const uint32_t entityId);
+		// Returns uninitialized memory for the component, moving the entity to a new archetype if needed
+		void* EmplaceComponent(const uint32_t entityId, const ComponentInfo& component);
+		void EraseComponent(const uint32_t entityId, const ComponentInfo& component);
+
+		void ClearEntityName(const uint32_t entityId);
+
+		// Bulk creation, values (count components of type overrideComponent) replace the prefab's value
+		std::vector<uint32_t> InstantiatePrefab(const Prefab& prefab, const size_t count, const ComponentInfo* overrideComponent, const void* values);
+
+		// Cached query (a sorted component signature and its matching archetypes). The archetype
+		// list is replaced rather than modified when an archetype is created, so views keep a snapshot
+		struct QueryCache
+		{
+			std::vector<ComponentTypeID> Signature;
+			Ref<const std::vector<Archetype*>> Archetypes;
+		};
+
+		// Query lookup & registration
+		Ref<const std::vector<Archetype*>> GetQueryArchetypes(const std::vector<ComponentTypeID>& signature);
+		static bool MatchesQuery(const Archetype* archetype, const QueryCache& query);
+
+		// Archetype lookup & creation (expects m_ComponentMutex to be held)
+		Archetype* GetOrCreateArchetype(std::vector<const ComponentInfo*> components);
+		Archetype* GetArchetypeWith(Archetype* source, const ComponentInfo& component);
+		Archetype* GetArchetypeWithout(Archetype* source, const ComponentInfo& component);
+		void MoveEntity(const uint32_t entityId, EntityRecord& record, Archetype* destination);
+
 	private:
-		uint32_t m_NextEntityID = 1;
-		std::unordered_map<uint32_t, std::unordered_map<std::type_index, Scope<Component>>> m_Components;
-		std::unordered_map<std::type_index, std::vector<uint32_t>> m_ComponentMap;
+		std::vector<Scope<Archetype>> m_Archetypes;
+		std::map<std::vector<ComponentTypeID>, Archetype*> m_ArchetypeMap;
+		std::map<std::vector<ComponentTypeID>, Scope<QueryCache>> m_Queries;
+		Archetype* m_RootArchetype = nullptr;
+		uint32_t m_ChangeTick = 1;
+		std::atomic<uint64_t> m_StructureVersion = 0;
+		std::vector<EntityRecord> m_EntityRecords;
+		// Freed slots are reused oldest first and only once enough of them wait, so churn is spread
+		// over many slots instead of burning through one slot's generations
+		std::deque<uint32_t> m_FreeIndices;
 		std::unordered_map<uint32_t, std::string> m_EntityNameMap;
 		std::unordered_map<std::string, uint32_t> m_NameEntityMap;
-		std::shared_mutex m_IdMutex;
+		std::unordered_map<std::thread::id, Scope<EntityCommandBuffer>> m_CommandBuffers;
 		std::shared_mutex m_ComponentMutex;
 		std::shared_mutex m_MapMutex;
+		std::mutex m_CommandBufferMutex;
+
+		friend class EntityCommandBuffer;
+		friend class SceneSerializer;
+		friend class SceneSnapshot;
 	};
 
 }
@@ -57,6 +169,14 @@ namespace Ares::ECS {
 
 namespace Ares::ECS {
 
+	// Instantiate
+	template <typename ECSComponent>
+	inline std::vector<uint32_t> EntityManager::Instantiate(const Prefab& prefab, const size_t count, const ECSComponent* values)
+	{
+		static_assert(std::is_copy_constructible_v<ECSComponent>, "Instantiated components must be copy constructible!");
+		return InstantiatePrefab(prefab, count, &ComponentInfo::Get<ECSComponent>(), values);
+	}
+
 	// AddComponent
 	template <typename ECSComponent, typename... Args>
 	inline ECSComponent* EntityManager::AddComponent(Entity& entity, Args&&... args)
@@ -67,11 +187,17 @@ namespace Ares::ECS {
 	template <typename ECSComponent, typename... Args>
 	inline ECSComponent* EntityManager::AddComponent(uint32_t entityId, Args&&... args)
 	{
+		const ComponentInfo& info = ComponentInfo::Get<ECSComponent>();
+
 		std::unique_lock<std::shared_mutex> lock(m_ComponentMutex);
-		auto& components = m_Components[entityId];
-		components[typeid(ECSComponent)] = CreateScope<ECSComponent>(std::forward<Args>(args)...);
-		m_ComponentMap[typeid(ECSComponent)].push_back(entityId);
-		return static_cast<ECSComponent*>(components[typeid(ECSComponent)].get());
+		void* component = EmplaceComponent(entityId, info);
+		if (component == nullptr)
+		{
+			AR_CORE_WARN("Tried to add a component to an entity that does not exist!");
+			return nullptr;
+		}
+
+		return new (component) ECSComponent(std::forward<Args>(args)...);
 	}
 
 	// RemoveComponent
@@ -84,10 +210,10 @@ namespace Ares::ECS {
 	template <typename ECSComponent>
 	inline void EntityManager::RemoveComponent(uint32_t entityId)
 	{
+		const ComponentInfo& info = ComponentInfo::Get<ECSComponent>();
+
 		std::unique_lock<std::shared_mutex> lock(m_ComponentMutex);
-		auto& components = m_Components[entityId];
-		components.erase(typeid(ECSComponent));
-		m_ComponentMap[typeid(ECSComponent)].erase(entityId);
+		EraseComponent(entityId, info);
 	}
 
 	// GetComponent
@@ -100,14 +226,33 @@ namespace Ares::ECS {
 	template <typename ECSComponent>
 	inline ECSComponent* EntityManager::GetComponent(uint32_t entityId)
 	{
-		std::unique_lock<std::shared_mutex> lock(m_ComponentMutex);
-		auto& components = m_Components[entityId];
-		auto it = components.find(typeid(ECSComponent));
-		if (it != components.end())
-		{
-			return static_cast<ECSComponent*>(it->second.get());
-		}
-		return nullptr;
+		std::shared_lock<std::shared_mutex> lock(m_ComponentMutex);
+		const EntityRecord* record = FindRecord(entityId);
+		if (record == nullptr)
+			return nullptr;
+
+		const int32_t column = record->Storage->GetColumnIndex(GetComponentTypeID<ECSComponent>());
+		if (column < 0)
+			return nullptr;
+
+		if constexpr (!std::is_const_v<ECSComponent>)
+			record->Storage->MarkChanged(record->Row / record->Storage->GetChunkCapacity(), column, m_ChangeTick);
+
+		return static_cast<ECSComponent*>(record->Storage->GetComponent(record->Row, column));
+	}
+
+	// Query
+	template <typename... ECSComponents>
+	inline View<ECSComponents...> EntityManager::Query()
+	{
+		static const std::vector<ComponentTypeID> s_Signature = []() {
+			std::vector<ComponentTypeID> signature = { GetComponentTypeID<ECSComponents>()... };
+			std::sort(signature.begin(), signature.end());
+			signature.erase(std::unique(signature.begin(), signature.end()), signature.end());
+			return signature;
+		}();
+
+		return View<ECSComponents...>(GetQueryArchetypes(s_Signature), m_ComponentMutex, m_ChangeTick);
 	}
 
 }
\ No newline at end of file
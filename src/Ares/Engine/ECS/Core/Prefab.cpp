@@ -0,0 +1,85 @@
+#include <arespch.h>
+#include "Engine/ECS/Core/Prefab.h"
+
+namespace Ares::ECS {
+
+	Prefab::~Prefab()
+	{
+		Clear();
+	}
+
+	Prefab::Prefab(Prefab&& other) noexcept
+		: m_Components(std::move(other.m_Components)), m_Data(std::move(other.m_Data))
+	{
+		other.m_Components.clear();
+		other.m_Data.clear();
+	}
+
+	Prefab& Prefab::operator=(Prefab&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Clear();
+			m_Components = std::move(other.m_Components);
+			m_Data = std::move(other.m_Data);
+			other.m_Components.clear();
+			other.m_Data.clear();
+		}
+		return *this;
+	}
+
+	const void* Prefab::GetComponentData(const ComponentTypeID type) const
+	{
+		const int32_t index = FindComponent(type);
+		return index >= 0 ? m_Data[index] : nullptr;
+	}
+
+	void* Prefab::EmplaceComponent(const ComponentInfo& component)
+	{
+		const int32_t index = FindComponent(component.Type);
+		if (index >= 0)
+		{
+			component.Destroy(m_Data[index]);
+			return m_Data[index];
+		}
+
+		void* data = ::operator new(component.Size, std::align_val_t(component.Alignment));
+		m_Components.push_back(&component);
+		m_Data.push_back(data);
+		return data;
+	}
+
+	void Prefab::EraseComponent(const ComponentInfo& component)
+	{
+		const int32_t index = FindComponent(component.Type);
+		if (index < 0)
+			return;
+
+		component.Destroy(m_Data[index]);
+		::operator delete(m_Data[index], std::align_val_t(component.Alignment));
+		m_Components.erase(m_Components.begin() + index);
+		m_Data.erase(m_Data.begin() + index);
+	}
+
+	int32_t Prefab::FindComponent(const ComponentTypeID type) const
+	{
+		for (size_t i = 0; i < m_Components.size(); i++)
+		{
+			if (m_Components[i]->Type == type)
+				return static_cast<int32_t>(i);
+		}
+		return -1;
+	}
+
+	void Prefab::Clear()
+	{
+		for (size_t i = 0; i < m_Components.size(); i++)
+		{
+			m_Components[i]->Destroy(m_Data[i]);
+			::operator delete(m_Data[i], std::align_val_t(m_Components[i]->Alignment));
+		}
+		m_Components.clear();
+		m_Data.clear();
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+#include "Engine/ECS/Core/ComponentInfo.h"
+
+namespace Ares::ECS {
+
+	// Prototype set of components with default values. EntityManager::Instantiate creates
+	// any number of entities from it in one go, each getting a copy of every prototype component.
+	class Prefab
+	{
+	public:
+		Prefab() = default;
+		~Prefab();
+
+		Prefab(const Prefab&) = delete;
+		Prefab& operator=(const Prefab&) = delete;
+		Prefab(Prefab&& other) noexcept;
+		Prefab& operator=(Prefab&& other) noexcept;
+
+		// Set the default value of a component, replacing the previous one
+		template <typename ECSComponent, typename... Args>
+		ECSComponent* AddComponent(Args&&... args);
+		template <typename ECSComponent>
+		void RemoveComponent();
+		template <typename ECSComponent>
+		ECSComponent* GetComponent() const;
+
+		inline const std::vector<const ComponentInfo*>& GetComponents() const { return m_Components; }
+		// Default value of a component, or nullptr if the prefab doesn't have it
+		const void* GetComponentData(const ComponentTypeID type) const;
+
+	private:
+		// Returns uninitialized memory for the component, destroying the previous value
+		void* EmplaceComponent(const ComponentInfo& component);
+		void EraseComponent(const ComponentInfo& component);
+		int32_t FindComponent(const ComponentTypeID type) const;
+		void Clear();
+
+	private:
+		std::vector<const ComponentInfo*> m_Components;
+		std::vector<void*> m_Data;
+	};
+
+	template <typename ECSComponent, typename... Args>
+	inline ECSComponent* Prefab::AddComponent(Args&&... args)
+	{
+		static_assert(std::is_copy_constructible_v<ECSComponent>, "Prefab components must be copy constructible!");
+		return new (EmplaceComponent(ComponentInfo::Get<ECSComponent>())) ECSComponent(std::forward<Args>(args)...);
+	}
+
+	template <typename ECSComponent>
+	inline void Prefab::RemoveComponent()
+	{
+		EraseComponent(ComponentInfo::Get<ECSComponent>());
+	}
+
+	template <typename ECSComponent>
+	inline ECSComponent* Prefab::GetComponent() const
+	{
+		const int32_t index = FindComponent(GetComponentTypeID<ECSComponent>());
+		return index >= 0 ? static_cast<ECSComponent*>(m_Data[index]) : nullptr;
+	}
+
+}
\ No newline at end of file
@@ -12,7 +12,8 @@ namespace Ares::ECS {
 		std::shared_lock<std::shared_mutex> lock(m_MapMutex);
 		for (auto& system : m_Systems)
 		{
-			system.second->OnInit(*this);
+			if (system != nullptr)
+				system->OnInit(*this);
 		}
 	}
 
@@ -21,39 +22,61 @@ namespace Ares::ECS {
 		std::shared_lock<std::shared_mutex> lock(m_MapMutex);
 		for (auto& system : m_Systems)
 		{
-			system.second->OnShutdown(*this);
+			if (system != nullptr)
+				system->OnShutdown(*this);
 		}
 	}
 
 	void Scene::OnUpdate(const Timestep& timestep)
 	{
-		std::shared_lock<std::shared_mutex> lock(m_OrderMutex);
-		if (m_UpdateOrder.size() > 0)
+		// Scenes that aren't rendered still get the previous frame's structural changes here
+		m_EntityManager->PlaybackCommandBuffers();
+
 		{
-			// Update based on update order
-			for (System* system : m_UpdateOrder)
+			std::unique_lock<std::shared_mutex> lock(m_OrderMutex);
+			if (m_ScheduleDirty)
 			{
-				system->OnUpdate(*this, timestep);
+				if (m_UpdateOrder.size() > 0)
+				{
+					// Schedule based on update order
+					m_Scheduler.Build(m_UpdateOrder);
+				}
+				else
+				{
+					// If no update order, schedule all systems randomly
+					std::shared_lock<std::shared_mutex> mapLock(m_MapMutex);
+					std::vector<System*> systems;
+					for (auto& entry : m_Systems)
+					{
+						if (entry != nullptr)
+							systems.push_back(entry.get());
+					}
+					m_Scheduler.Build(systems);
+				}
+				m_ScheduleDirty = false;
 			}
 		}
-		else
+
+		// Systems that don't conflict are updated in parallel
 		{
-			// If no update order, update all systems randomly
-			std::shared_lock<std::shared_mutex> lock(m_MapMutex);
-			for (auto& entry : m_Systems)
-			{
-				entry.second->OnUpdate(*this, timestep);
-			}
+			std::shared_lock<std::shared_mutex> lock(m_OrderMutex);
+			m_Scheduler.Run(*this, timestep);
 		}
 	}
 
 	void Scene::OnRender()
 	{
-		std::shared_lock<std::shared_mutex> lock(m_OrderMutex);
-		for (System* system : m_RenderOrder)
 		{
-			system->OnRender(*this);
+			std::shared_lock<std::shared_mutex> lock(m_OrderMutex);
+			for (System* system : m_RenderOrder)
+			{
+				system->OnRender(*this);
+			}
 		}
+
+		// Sync point for structural changes recorded while systems were running. It comes after
+		// rendering so component pointers gathered during the update stay valid for the whole frame
+		m_EntityManager->PlaybackCommandBuffers();
 	}
 
 	EntityManager* Scene::GetEntityManager() const
@@ -61,4 +84,11 @@ namespace Ares::ECS {
 		return m_EntityManager.get();
 	}
 
+	System* Scene::FindSystem(const uint32_t systemTypeId) const
+	{
+		if (systemTypeId < m_Systems.size())
+			return m_Systems[systemTypeId].get();
+		return nullptr;
+	}
+
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #pragma once
+#include "Engine/Core/TypeID.h"
+#include "Engine/ECS/Core/SystemScheduler.h"
 
 namespace Ares {
 
@@ -18,7 +20,8 @@ namespace Ares {
 			void Init();
 			void Shutdown();
 
-			// Update & render all relevant systems
+			// Update & render all relevant systems. Structural changes recorded in command buffers
+			// are played back after OnRender (or before the next OnUpdate when the scene isn't rendered)
 			void OnUpdate(const Timestep& timestep);
 			void OnRender();
 
@@ -41,48 +44,47 @@ namespace Ares {
 			template <typename... Systems>
 			void SetSystemRenderOrder();
 
+		private:
+			// Looks up a registered system by its type id (expects m_MapMutex to be held)
+			System* FindSystem(const uint32_t systemTypeId) const;
+
 		private:
 			Scope<EntityManager> m_EntityManager = CreateScope<EntityManager>();
-			std::atomic<uint32_t> m_NextSystemId{ 1 };
-			std::unordered_map<uint32_t, Scope<System>> m_Systems;
-			std::unordered_map<std::type_index, uint32_t> m_SystemIdMap;
+			// Indexed by system type id (TypeID<System>), empty slots for unregistered systems
+			std::vector<Scope<System>> m_Systems;
 			std::vector<System*> m_UpdateOrder;
 			std::vector<System*> m_RenderOrder;
+			SystemScheduler m_Scheduler;
+			bool m_ScheduleDirty = true;
 			mutable std::shared_mutex m_MapMutex;
 			mutable std::shared_mutex m_OrderMutex;
-			mutable std::shared_mutex m_IdMutex;
 		};
 
 		template <typename System, typename... Args>
 		void Scene::RegisterSystem(Args&&... args)
 		{
-			uint32_t currentId = 0;
+			const uint32_t systemTypeId = TypeID<ECS::System>::Get<System>();
 			{
-				std::unique_lock<std::shared_mutex> lock(m_IdMutex);
-				currentId = m_NextSystemId++;
+				std::unique_lock<std::shared_mutex> lock(m_MapMutex);
+				if (systemTypeId >= m_Systems.size())
+					m_Systems.resize(systemTypeId + 1);
+				// The update and render orders hold raw pointers to the registered instance
+				if (m_Systems[systemTypeId] != nullptr)
+				{
+					AR_CORE_WARN("Scene already has this system!");
+					return;
+				}
+				m_Systems[systemTypeId] =CreateScope<System>(std::forward<Args>(args)...);
 			}
-			std::unique_lock<std::shared_mutex> lock(m_MapMutex);
-			m_Systems[currentId] = CreateScope<System>(std::forward<Args>(args)...);
-			m_SystemIdMap[typeid(System)] = currentId;
+			std::unique_lock<std::shared_mutex> lock(m_OrderMutex);
+			m_ScheduleDirty = true;
 		}
 
 		template <typename System>
 		System* Scene::GetSystem() const
 		{
 			std::shared_lock<std::shared_mutex> lock(m_MapMutex);
-			auto itMap = m_SystemIdMap.find(typeid(System));
-			if (itMap != m_SystemIdMap.end())
-			{
-				auto itSys = m_Systems.find(itMap->second);
-				if (itSys != m_Systems.end())
-					return static_cast<System*>(itSys->second.get());
-
-				return nullptr;
-			}
-			else
-			{
-				return nullptr;
-			}
+			return static_cast<System*>(FindSystem(TypeID<ECS::System>::Get<System>()));
 		}
 
 		template <typename... Systems>
@@ -91,15 +93,16 @@ namespace Ares {
 			std::unique_lock<std::shared_mutex> lock1(m_OrderMutex);
 			std::shared_lock<std::shared_mutex> lock2(m_MapMutex);
 			m_UpdateOrder.clear();
+			m_ScheduleDirty = true;
 
 			// Process each system type in the parameter pack
 			(void([&]() {
-				// Find the system id
-				auto it = m_SystemIdMap.find(typeid(Systems));
-				if (it != m_SystemIdMap.end())
+				// Find the system by its type id
+				System* system = FindSystem(TypeID<ECS::System>::Get<Systems>());
+				if (system != nullptr)
 				{
 					// Add the system pointer to the update order
-					m_UpdateOrder.push_back(m_Systems[it->second].get());
+					m_UpdateOrder.push_back(system);
 				}
 				else
 				{
@@ -115,12 +118,12 @@ namespace Ares {
 
 			// Process each system type in parameter pack
 			(void([&]() {
-				// Find the system id
-				auto it = m_SystemIdMap.find(typeid(Systems));
-				if (it != m_SystemIdMap.end())
+				// Find the system by its type id
+				System* system = FindSystem(TypeID<ECS::System>::Get<Systems>());
+				if (system != nullptr)
 				{
 					// Add the system pointer to the render order
-					m_RenderOrder.push_back(m_Systems[it->second].get());
+					m_RenderOrder.push_back(system);
 				}
 				else
 				{
@@ -0,0 +1,634 @@
+#include <arespch.h>
+#include "Engine/ECS/Core/SceneSerializer.h"
+
+#include "Engine/Data/Asset.h"
+#include "Engine/Data/AssetManager.h"
+#include "Engine/Data/DataBuffer.h"
+#include "Engine/Data/FileIO.h"
+#include "Engine/Data/MappedFile.h"
+#include "Engine/ECS/Components/AllComponents.h"
+#include "Engine/ECS/Core/EntityManager.h"
+
+namespace Ares::ECS {
+
+	std::vector<SceneSerializer::SerializedComponent> SceneSerializer::s_Components;
+	std::mutex SceneSerializer::s_Mutex;
+
+	// Reader
+	bool SceneSerializer::Reader::Read(void* destination, const size_t size)
+	{
+		if (GetRemaining() < size)
+			return false;
+
+		std::memcpy(destination, m_Data, size);
+		m_Data += size;
+		return true;
+	}
+
+	bool SceneSerializer::Reader::ReadString(std::string& value)
+	{
+		uint32_t length = 0;
+		if (!Read(length) || GetRemaining() < length)
+			return false;
+
+		value.assign(reinterpret_cast<const char*>(m_Data), length);
+		m_Data += length;
+		return true;
+	}
+
+	bool SceneSerializer::Reader::Skip(const size_t size)
+	{
+		if (GetRemaining() < size)
+			return false;
+
+		m_Data += size;
+		return true;
+	}
+
+	bool SceneSerializer::Reader::Align(const size_t alignment)
+	{
+		const size_t offset = m_Data - m_Start;
+		return Skip((alignment - offset % alignment) % alignment);
+	}
+
+	// Writer
+	void SceneSerializer::Writer::Write(const void* data, const size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		m_Buffer->insert(m_Buffer->end(), bytes, bytes + size);
+	}
+
+	void SceneSerializer::Writer::WriteString(const std::string& value)
+	{
+		Write(static_cast<uint32_t>(value.size()));
+		Write(value.data(), value.size());
+	}
+
+	void SceneSerializer::Writer::Align(const size_t alignment)
+	{
+		m_Buffer->resize((m_Buffer->size() + alignment - 1) / alignment * alignment, 0);
+	}
+
+	// Saving
+	bool SceneSerializer::Save(EntityManager* entityManager, const std::string& filepath)
+	{
+		RegisterDefaultComponents();
+
+		std::vector<uint8_t> buffer;
+		Writer writer(buffer);
+		{
+			std::shared_lock lock(entityManager->m_ComponentMutex);
+
+			FileHeader header = { Magic, Version, 0, 0 };
+			for (const Scope<Archetype>& archetype : entityManager->m_Archetypes)
+			{
+				if (archetype->GetEntityCount() > 0)
+					header.ArchetypeCount++;
+			}
+			{
+				std::shared_lock mapLock(entityManager->m_MapMutex);
+				header.NameCount = static_cast<uint32_t>(entityManager->m_EntityNameMap.size());
+			}
+			writer.Write(header);
+			writer.Align(BlockAlignment);
+
+			for (const Scope<Archetype>& archetype : entityManager->m_Archetypes)
+			{
+				if (archetype->GetEntityCount() > 0)
+					SaveArchetype(archetype.get(), writer);
+			}
+		}
+
+		// Entity names
+		{
+			std::shared_lock lock(entityManager->m_MapMutex);
+			for (const auto& [entityId, name] : entityManager->m_EntityNameMap)
+			{
+				writer.Write(entityId);
+				writer.WriteString(name);
+			}
+		}
+
+		return FileIO::SaveFile(filepath, DataBuffer(buffer.data(), buffer.size()));
+	}
+
+	void SceneSerializer::SaveArchetype(const Archetype* archetype, Writer& writer)
+	{
+		// Only registered components are saved
+		std::vector<std::pair<size_t, const SerializedComponent*>> columns;
+		for (size_t column = 0; column < archetype->GetComponents().size(); column++)
+		{
+			const SerializedComponent* component = FindComponent(archetype->GetSignature()[column]);
+			if (component != nullptr)
+				columns.emplace_back(column, component);
+		}
+
+		const ArchetypeHeader header = {
+			static_cast<uint32_t>(archetype->GetEntityCount()),
+			static_cast<uint32_t>(columns.size())
+		};
+		writer.Write(header);
+
+		// Saved entity ids, used to remap references between entities on load
+		for (size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++)
+			writer.Write(archetype->GetEntities(chunk), archetype->GetChunkEntityCount(chunk) * sizeof(uint32_t));
+		writer.Align(BlockAlignment);
+
+		std::vector<uint8_t> blockData;
+		for (const auto& [column, component] : columns)
+		{
+			const size_t elementSize = component->Info->Size;
+			BlockHeader block = { component->NameHash, 0, 0, 0 };
+
+			if (component->Write == nullptr)
+			{
+				// Raw block, one contiguous array of every component
+				block.ElementSize = static_cast<uint32_t>(elementSize);
+				block.DataSize = archetype->GetEntityCount() * elementSize;
+				writer.Write(block);
+				writer.Align(BlockAlignment);
+				for (size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++)
+					writer.Write(archetype->GetColumn(chunk, column), archetype->GetChunkEntityCount(chunk) * elementSize);
+			}
+			else
+			{
+				blockData.clear();
+				Writer blockWriter(blockData);
+				for (uint32_t row = 0; row < archetype->GetEntityCount(); row++)
+					component->Write(archetype->GetComponent(row, column), blockWriter);
+
+				block.DataSize = blockData.size();
+				writer.Write(block);
+				writer.Align(BlockAlignment);
+				writer.Write(blockData.data(), blockData.size());
+			}
+			writer.Align(BlockAlignment);
+		}
+	}
+
+	// Loading
+	bool SceneSerializer::Load(EntityManager* entityManager, const std::string& filepath)
+	{
+		RegisterDefaultComponents();
+
+		MappedFile file(filepath);
+		if (!file)
+			return false;
+
+		Reader reader(file.GetData(), file.GetSize());
+		FileHeader header;
+		if (!reader.Read(header) || header.Magic != Magic)
+		{
+			AR_CORE_WARN("Not a scene file: '{}'", filepath);
+			return false;
+		}
+		if (header.Version != Version)
+		{
+			AR_CORE_WARN("Unsupported scene file version {} (expected {}): '{}'", header.Version, Version, filepath);
+			return false;
+		}
+		reader.Align(BlockAlignment);
+
+		// Loaded entities get new ids, keep track of them to fix up references between entities
+		std::unordered_map<uint32_t, uint32_t> entityMap;
+		bool result = true;
+
+		// New entities & components get their own change tick
+		entityManager->AdvanceChangeTick();
+		{
+			std::unique_lock lock(entityManager->m_ComponentMutex);
+			for (uint32_t i = 0; i < header.ArchetypeCount; i++)
+			{
+				if (!LoadArchetype(entityManager, reader, entityMap))
+				{
+					AR_CORE_WARN("Scene file is corrupted, stopped loading: '{}'", filepath);
+					result = false;
+					break;
+				}
+			}
+
+			const EntityRemap remap = { entityMap };
+			for (const auto& [savedId, entityId] : entityMap)
+			{
+				const EntityManager::EntityRecord* record = entityManager->FindRecord(entityId);
+				const std::vector<const ComponentInfo*>& components = record->Storage->GetComponents();
+				for (size_t column = 0; column < components.size(); column++)
+				{
+					const SerializedComponent* component = FindComponent(components[column]->Type);
+					if (component != nullptr && component->Remap != nullptr)
+						component->Remap(record->Storage->GetComponent(record->Row, column), remap);
+				}
+			}
+		}
+
+		// Entity names
+		for (uint32_t i = 0; result && i < header.NameCount; i++)
+		{
+			uint32_t savedId = 0;
+			std::string name;
+			if (!reader.Read(savedId) || !reader.ReadString(name))
+			{
+				AR_CORE_WARN("Scene file is corrupted, stopped loading: '{}'", filepath);
+				result = false;
+				break;
+			}
+
+			auto it = entityMap.find(savedId);
+			if (it != entityMap.end())
+			{
+				Entity entity(it->second, entityManager);
+				entityManager->SetEntityName(entity, name);
+			}
+		}
+
+		return result;
+	}
+
+	bool SceneSerializer::LoadArchetype(EntityManager* entityManager, Reader& reader, std::unordered_map<uint32_t, uint32_t>& entityMap)
+	{
+		ArchetypeHeader header;
+		if (!reader.Read(header))
+			return false;
+
+		const uint32_t* savedIds = reinterpret_cast<const uint32_t*>(reader.GetPosition());
+		if (!reader.Skip(header.EntityCount * sizeof(uint32_t)) || !reader.Align(BlockAlignment))
+			return false;
+
+		// Validate every block before creating any entity
+		struct Block
+		{
+			const SerializedComponent* Component;
+			const uint8_t* Data;
+			size_t Size;
+		};
+		std::vector<Block> blocks;
+		std::vector<const ComponentInfo*> components;
+		for (uint32_t i = 0; i < header.ComponentCount; i++)
+		{
+			BlockHeader block;
+			if (!reader.Read(block) || !reader.Align(BlockAlignment))
+				return false;
+
+			const uint8_t* data = reader.GetPosition();
+			if (!reader.Skip(block.DataSize) || !reader.Align(BlockAlignment))
+				return false;
+
+			const SerializedComponent* component = FindComponent(block.NameHash);
+			if (component == nullptr)
+			{
+				AR_CORE_WARN("Skipping unregistered component in scene file!");
+				continue;
+			}
+			if ((component->Write == nullptr) != (block.ElementSize != 0))
+			{
+				AR_CORE_WARN("Skipping component saved with a different serialization!");
+				continue;
+			}
+			if (block.ElementSize != 0 && (block.ElementSize != component->Info->Size || block.DataSize != static_cast<uint64_t>(block.ElementSize) * header.EntityCount))
+			{
+				AR_CORE_WARN("Skipping component with a different size than the one in the scene file!");
+				continue;
+			}
+			if (std::find(components.begin(), components.end(), component->Info) != components.end())
+				continue;
+
+			blocks.push_back({ component, data, static_cast<size_t>(block.DataSize) });
+			components.push_back(component->Info);
+		}
+
+		if (header.EntityCount == 0)
+			return true;
+
+		if (header.EntityCount > entityManager->GetAvailableRecordCount())
+		{
+			AR_CORE_ERROR("Scene has {} entities, only {} entity slots are left!", header.EntityCount, entityManager->GetAvailableRecordCount());
+			return false;
+		}
+
+		// Create every entity straight in its final archetype
+		Archetype* archetype = entityManager->GetOrCreateArchetype(components);
+		const uint32_t firstRow = static_cast<uint32_t>(archetype->GetEntityCount());
+		for (uint32_t i = 0; i < header.EntityCount; i++)
+		{
+			const uint32_t entityId = entityManager->CreateEntityRecord(archetype);
+			entityMap[savedIds[i]] = entityId;
+		}
+
+		bool result = true;
+		const size_t capacity = archetype->GetChunkCapacity();
+		for (const Block& block : blocks)
+		{
+			const size_t column = static_cast<size_t>(archetype->GetColumnIndex(block.Component->Info->Type));
+			const size_t elementSize = block.Component->Info->Size;
+			archetype->MarkAdded(firstRow, column, entityManager->m_ChangeTick);
+
+			if (block.Component->Read == nullptr)
+			{
+				// Copy the raw array chunk by chunk
+				size_t row = firstRow;
+				const uint8_t* source = block.Data;
+				while (row < firstRow + header.EntityCount)
+				{
+					const size_t chunk = row / capacity;
+					const size_t index = row % capacity;
+					const size_t count = std::min(capacity - index, firstRow + header.EntityCount - row);
+					std::memcpy(archetype->GetColumn(chunk, column) + index * elementSize, source, count * elementSize);
+					archetype->MarkAdded(static_cast<uint32_t>(row), column, entityManager->m_ChangeTick);
+
+					source += count * elementSize;
+					row += count;
+				}
+			}
+			else
+			{
+				Reader blockReader(block.Data, block.Size);
+				for (uint32_t row = firstRow; row < firstRow + header.EntityCount; row++)
+				{
+					if (row % capacity == 0)
+						archetype->MarkAdded(row, column, entityManager->m_ChangeTick);
+					result &= block.Component->Read(archetype->GetComponent(row, column), blockReader);
+				}
+			}
+		}
+
+		return result;
+	}
+
+	uint32_t SceneSerializer::EntityRemap::operator()(const uint32_t entityId) const
+	{
+		auto it = Map.find(entityId);
+		if (it != Map.end())
+			return it->second;
+		return KeepUnmapped ? entityId : EntityID::Invalid;
+	}
+
+	// Registry
+	void SceneSerializer::RegisterComponent(const std::string& name, const ComponentInfo& info, WriteFn write, ReadFn read, RemapFn remap)
+	{
+		std::unique_lock lock(s_Mutex);
+		const uint64_t nameHash = HashName(name);
+		for (const SerializedComponent& component : s_Components)
+		{
+			if (component.NameHash == nameHash || component.Info == &info)
+			{
+				AR_CORE_WARN("Component '{}' is already registered for serialization!", name);
+				return;
+			}
+		}
+		s_Components.push_back({ nameHash, &info, write, read, remap });
+	}
+
+	const SceneSerializer::SerializedComponent* SceneSerializer::FindComponent(const ComponentTypeID type)
+	{
+		std::unique_lock lock(s_Mutex);
+		for (const SerializedComponent& component : s_Components)
+		{
+			if (component.Info->Type == type)
+				return &component;
+		}
+		return nullptr;
+	}
+
+	const SceneSerializer::SerializedComponent* SceneSerializer::FindComponent(const uint64_t nameHash)
+	{
+		std::unique_lock lock(s_Mutex);
+		for (const SerializedComponent& component : s_Components)
+		{
+			if (component.NameHash == nameHash)
+				return &component;
+		}
+		return nullptr;
+	}
+
+	namespace {
+
+		// Asset references are stored by name
+		void WriteAsset(const Ref<Asset>& asset, SceneSerializer::Writer& writer)
+		{
+			writer.WriteString(asset != nullptr ? asset->GetName() : std::string());
+		}
+
+		bool ReadAsset(Ref<Asset>& asset, SceneSerializer::Reader& reader)
+		{
+			std::string name;
+			if (!reader.ReadString(name))
+				return false;
+
+			asset = name.empty() ? nullptr : AssetManager::GetAsset(name);
+			if (!name.empty() && asset == nullptr)
+				AR_CORE_WARN("Scene references asset '{}', which isn't staged!", name);
+			return true;
+		}
+
+	}
+
+	void SceneSerializer::RegisterDefaultComponents()
+	{
+		static std::once_flag s_Registered;
+		std::call_once(s_Registered, []() {
+			RegisterComponent<Components::Transform>("Transform");
+			RegisterComponent<Components::Camera>("Camera");
+			RegisterComponent<Components::Light>("Light");
+
+			// Hierarchy
+			RegisterComponent<Components::Parent>("Parent", [](void* component, const EntityRemap& remap) {
+				Components::Parent* parent = static_cast<Components::Parent*>(component);
+				parent->EntityId = remap(parent->EntityId);
+			});
+			RegisterComponent<Components::Children>("Children",
+				[](const void* component, Writer& writer) {
+					const Components::Children* children = static_cast<const Components::Children*>(component);
+					writer.Write(static_cast<uint32_t>(children->EntityIds.size()));
+					writer.Write(children->EntityIds.data(), children->EntityIds.size() * sizeof(uint32_t));
+				},
+				[](void* destination, Reader& reader) {
+					Components::Children* children = new (destination) Components::Children();
+					uint32_t count = 0;
+					if (!reader.Read(count) || reader.GetRemaining() < count * sizeof(uint32_t))
+						return false;
+					children->EntityIds.resize(count);
+					return reader.Read(children->EntityIds.data(), count * sizeof(uint32_t));
+				},
+				[](void* component, const EntityRemap& remap) {
+					Components::Children* children = static_cast<Components::Children*>(component);
+					for (uint32_t& entityId : children->EntityIds)
+						entityId = remap(entityId);
+					std::erase(children->EntityIds, EntityID::Invalid);
+				}
+			);
+
+			// Rendering
+			RegisterComponent<Components::Mesh>("Mesh",
+				[](const void* component, Writer& writer) {
+					// Either a single asset or every level of the LOD chain, followed by the current level
+					const Components::Mesh* mesh = static_cast<const Components::Mesh*>(component);
+					const uint32_t levelCount = mesh->m_LODChain != nullptr ? static_cast<uint32_t>(mesh->m_LODChain->Levels.size()) : 0;
+					writer.Write(levelCount);
+					if (levelCount == 0)
+						WriteAsset(mesh->m_MeshAsset, writer);
+					for (uint32_t i = 0; i < levelCount; i++)
+					{
+						WriteAsset(mesh->m_LODChain->Levels[i].MeshAsset, writer);
+						writer.Write(mesh->m_LODChain->Levels[i].ScreenSize);
+					}
+					writer.Write(mesh->m_LODLevel);
+				},
+				[](void* destination, Reader& reader) {
+					uint32_t levelCount = 0;
+					if (!reader.Read(levelCount))
+					{
+						new (destination) Components::Mesh(Ref<Asset>(nullptr));
+						return false;
+					}
+
+					if (levelCount == 0)
+					{
+						Ref<Asset> asset;
+						const bool result = ReadAsset(asset, reader);
+						Components::Mesh* mesh = new (destination) Components::Mesh(asset);
+						return result && reader.Read(mesh->m_LODLevel);
+					}
+
+					// Chains aren't shared between the loaded meshes, every entity gets its own copy
+					Ref<Components::MeshLODChain> lodChain = CreateRef<Components::MeshLODChain>();
+					bool complete = true;
+					for (uint32_t i = 0; i < levelCount; i++)
+					{
+						Components::MeshLODChain::Level& level = lodChain->Levels.emplace_back();
+						if (!ReadAsset(level.MeshAsset, reader) || !reader.Read(level.ScreenSize))
+						{
+							new (destination) Components::Mesh(Ref<Asset>(nullptr));
+							return false;
+						}
+						complete = complete && level.MeshAsset != nullptr;
+					}
+
+					uint32_t currentLevel = 0;
+					const bool result = reader.Read(currentLevel);
+
+					// A chain with missing assets makes an invalid mesh, like a missing single asset
+					if (!complete)
+					{
+						new (destination) Components::Mesh(Ref<Asset>(nullptr));
+						return result;
+					}
+
+					Components::Mesh* mesh = new (destination) Components::Mesh(lodChain);
+					if (currentLevel < levelCount)
+					{
+						mesh->m_LODLevel = currentLevel;
+						mesh->m_MeshAsset = lodChain->Levels[currentLevel].MeshAsset;
+						mesh->UpdateBatchKey();
+					}
+					return result;
+				}
+			);
+			RegisterComponent<Components::Material>("Material",
+				[](const void* component, Writer& writer) {
+					const Components::Material* material = static_cast<const Components::Material*>(component);
+					WriteAsset(material->m_ShaderAsset, writer);
+
+					writer.Write(static_cast<uint32_t>(material->m_TextureAssets.size()));
+					for (const auto& [name, texture] : material->m_TextureAssets)
+					{
+						writer.WriteString(name);
+						WriteAsset(texture, writer);
+					}
+
+					// Uniform properties, every alternative is plain data
+					writer.Write(static_cast<uint32_t>(material->m_Properties.size()));
+					for (const auto& [name, id, property] : material->m_Properties)
+					{
+						writer.WriteString(name);
+						writer.Write(static_cast<uint8_t>(property.index()));
+						std::visit([&writer](const auto& value) { writer.Write(value); }, property);
+					}
+
+					const Components::MaterialProperties& properties = material->m_MaterialProperties;
+					writer.Write(properties.Basic.Color);
+					writer.Write(properties.Basic.Alpha);
+					writer.Write(properties.Surface.Roughness);
+					writer.Write(properties.Surface.Metallic);
+					writer.Write(properties.Surface.Reflectivity);
+					writer.Write(properties.Surface.EmissiveColor);
+					writer.Write(properties.Surface.EmissiveIntensity);
+				},
+				[](void* destination, Reader& reader) {
+					Components::Material* material = new (destination) Components::Material();
+					if (!ReadAsset(material->m_ShaderAsset, reader))
+						return false;
+
+					uint32_t textureCount = 0;
+					if (!reader.Read(textureCount))
+						return false;
+					for (uint32_t i = 0; i < textureCount; i++)
+					{
+						std::string name;
+						Ref<Asset> texture;
+						if (!reader.ReadString(name) || !ReadAsset(texture, reader))
+							return false;
+						if (texture != nullptr)
+							material->m_TextureAssets[name] = texture;
+					}
+					material->UpdateBatchKey();
+
+					uint32_t propertyCount = 0;
+					if (!reader.Read(propertyCount))
+						return false;
+					for (uint32_t i = 0; i < propertyCount; i++)
+					{
+						std::string name;
+						uint8_t index = 0;
+						if (!reader.ReadString(name) || !reader.Read(index))
+							return false;
+
+						bool valid = false;
+						// Names are kept on disk, the id is resolved when loading
+						const UniformID id(name);
+						material->m_Properties.push_back({ std::move(name), id, {} });
+						auto& property = material->m_Properties.back().Value;
+						auto readAlternative = [&]<size_t... Indices>(std::index_sequence<Indices...>) {
+							((Indices == index ? (valid = reader.Read(property.template emplace<Indices>()), void()) : void()), ...);
+						};
+						readAlternative(std::make_index_sequence<std::variant_size_v<std::remove_reference_t<decltype(property)>>>{});
+						if (!valid)
+							return false;
+					}
+
+					Components::MaterialProperties& properties = material->m_MaterialProperties;
+					return reader.Read(properties.Basic.Color) && reader.Read(properties.Basic.Alpha) &&
+						reader.Read(properties.Surface.Roughness) && reader.Read(properties.Surface.Metallic) &&
+						reader.Read(properties.Surface.Reflectivity) && reader.Read(properties.Surface.EmissiveColor) &&
+						reader.Read(properties.Surface.EmissiveIntensity);
+				}
+			);
+			RegisterComponent<Components::Occluder>("Occluder",
+				[](const void* component, Writer& writer) {
+					const Components::Occluder* occluder = static_cast<const Components::Occluder*>(component);
+					writer.Write(static_cast<uint32_t>(occluder->Vertices.size()));
+					writer.Write(occluder->Vertices.data(), occluder->Vertices.size() * sizeof(glm::vec3));
+					writer.Write(static_cast<uint32_t>(occluder->Indices.size()));
+					writer.Write(occluder->Indices.data(), occluder->Indices.size() * sizeof(uint32_t));
+				},
+				[](void* destination, Reader& reader) {
+					Components::Occluder* occluder = new (destination) Components::Occluder();
+					uint32_t vertexCount = 0;
+					if (!reader.Read(vertexCount) || reader.GetRemaining() < vertexCount * sizeof(glm::vec3))
+						return false;
+					occluder->Vertices.resize(vertexCount);
+					if (!reader.Read(occluder->Vertices.data(), vertexCount * sizeof(glm::vec3)))
+						return false;
+
+					uint32_t indexCount = 0;
+					if (!reader.Read(indexCount) || reader.GetRemaining() < indexCount * sizeof(uint32_t))
+						return false;
+					occluder->Indices.resize(indexCount);
+					if (!reader.Read(occluder->Indices.data(), indexCount * sizeof(uint32_t)))
+						return false;
+					return std::all_of(occluder->Indices.begin(), occluder->Indices.end(), [vertexCount](const uint32_t index) { return index < vertexCount; });
+				}
+			);
+		});
+	}
+
+}
\ No newline at end of file
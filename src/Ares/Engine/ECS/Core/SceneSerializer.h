@@ -0,0 +1,178 @@
+#pragma once
+#include "Engine/ECS/Core/ComponentInfo.h"
+
+namespace Ares::ECS {
+
+	class Archetype;
+	class EntityManager;
+
+	// Saves & loads entities to a versioned binary scene file.
+	//
+	// The file is laid out per archetype: the entity ids of the archetype followed by one block
+	// per component type. Trivially copyable components are stored as raw arrays that the loader
+	// copies straight into chunk memory, other components go through custom read & write functions.
+	// Loading memory-maps the file and creates each archetype's entities in one go.
+	//
+	// Components are identified by a stable name (not their runtime type id), so only registered
+	// components are saved. Asset references are stored by asset name and resolved through the
+	// AssetManager, so stage the assets a scene uses before loading it.
+	class SceneSerializer
+	{
+	public:
+		static constexpr uint32_t Magic = 0x43535241; // "ARSC"
+		static constexpr uint32_t Version = 2;
+		static constexpr size_t BlockAlignment = 16;
+
+		// Bounds checked reader over a block of the file
+		class Reader
+		{
+		public:
+			Reader(const uint8_t* data, const size_t size)
+				: m_Start(data), m_Data(data), m_End(data + size)
+			{
+			}
+
+			bool Read(void* destination, const size_t size);
+			template <typename T>
+			bool Read(T& value) { return Read(&value, sizeof(T)); }
+			bool ReadString(std::string& value);
+			bool Skip(const size_t size);
+			// Skip to the next multiple of alignment (relative to the start of the data)
+			bool Align(const size_t alignment);
+
+			inline const uint8_t* GetPosition() const { return m_Data; }
+			inline size_t GetRemaining() const { return m_End - m_Data; }
+
+		private:
+			const uint8_t* m_Start;
+			const uint8_t* m_Data;
+			const uint8_t* m_End;
+		};
+
+		// Appends to a file buffer
+		class Writer
+		{
+		public:
+			Writer(std::vector<uint8_t>& buffer)
+				: m_Buffer(&buffer)
+			{
+			}
+
+			void Write(const void* data, const size_t size);
+			template <typename T>
+			void Write(const T& value) { Write(&value, sizeof(T)); }
+			void WriteString(const std::string& value);
+			// Pad with zeros to the next multiple of alignment
+			void Align(const size_t alignment);
+			inline size_t GetSize() const { return m_Buffer->size(); }
+
+		private:
+			std::vector<uint8_t>* m_Buffer;
+		};
+
+		// Writes one component
+		using WriteFn = void(*)(const void* component, Writer& writer);
+		// Constructs one component at destination. Has to construct it even if the data is bad (returning false).
+		using ReadFn = bool(*)(void* destination, Reader& reader);
+		// Maps saved entity ids to the ids of the entities they were loaded as
+		struct EntityRemap
+		{
+			const std::unordered_map<uint32_t, uint32_t>& Map;
+			// Keep ids missing from the map as they are, instead of invalidating them
+			bool KeepUnmapped = false;
+
+			uint32_t operator()(const uint32_t entityId) const;
+		};
+		// Maps the entity ids stored in a loaded component from the saved ids to the new ones
+		using RemapFn = void(*)(void* component, const EntityRemap& remap);
+
+	public:
+		// Save every entity with its registered components
+		static bool Save(EntityManager* entityManager, const std::string& filepath);
+		// Load a scene file, adding its entities to the ones already in the entity manager
+		static bool Load(EntityManager* entityManager, const std::string& filepath);
+
+		// Register a trivially copyable component, stored as raw arrays
+		template <typename ECSComponent>
+		static void RegisterComponent(const std::string& name, RemapFn remap = nullptr);
+		// Register a component with custom read & write functions
+		template <typename ECSComponent>
+		static void RegisterComponent(const std::string& name, WriteFn write, ReadFn read, RemapFn remap = nullptr);
+
+	private:
+		struct SerializedComponent
+		{
+			uint64_t NameHash;
+			const ComponentInfo* Info;
+			// Raw components have no read or write functions
+			WriteFn Write;
+			ReadFn Read;
+			RemapFn Remap;
+		};
+
+		// On-disk layout
+		struct FileHeader
+		{
+			uint32_t Magic;
+			uint32_t Version;
+			uint32_t ArchetypeCount;
+			uint32_t NameCount;
+		};
+
+		struct ArchetypeHeader
+		{
+			uint32_t EntityCount;
+			uint32_t ComponentCount;
+		};
+
+		struct BlockHeader
+		{
+			uint64_t NameHash;
+			// Size of one element for raw blocks, 0 for blocks using custom read & write functions
+			uint32_t ElementSize;
+			uint32_t Padding;
+			uint64_t DataSize;
+		};
+
+		static void RegisterComponent(const std::string& name, const ComponentInfo& info, WriteFn write, ReadFn read, RemapFn remap);
+		static void RegisterDefaultComponents();
+		static const SerializedComponent* FindComponent(const ComponentTypeID type);
+		static const SerializedComponent* FindComponent(const uint64_t nameHash);
+
+		static void SaveArchetype(const Archetype* archetype, Writer& writer);
+		static bool LoadArchetype(EntityManager* entityManager, Reader& reader, std::unordered_map<uint32_t, uint32_t>& entityMap);
+
+		// FNV-1a, stable across builds & platforms
+		static constexpr uint64_t HashName(const std::string_view name)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (const char c : name)
+			{
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+	private:
+		static std::vector<SerializedComponent> s_Components;
+		static std::mutex s_Mutex;
+
+		friend class SceneSnapshot;
+	};
+
+	template <typename ECSComponent>
+	inline void SceneSerializer::RegisterComponent(const std::string& name, RemapFn remap)
+	{
+		static_assert(std::is_trivially_copyable_v<ECSComponent>, "Raw components must be trivially copyable!");
+		RegisterComponent(name, ComponentInfo::Get<ECSComponent>(), nullptr, nullptr, remap);
+	}
+
+	template <typename ECSComponent>
+	inline void SceneSerializer::RegisterComponent(const std::string& name, WriteFn write, ReadFn read, RemapFn remap)
+	{
+		AR_CORE_ASSERT(write != nullptr && read != nullptr, "Custom components need both a read & write function!");
+		RegisterComponent(name, ComponentInfo::Get<ECSComponent>(), write, read, remap);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,642 @@
+#include <arespch.h>
+#include "Engine/ECS/Core/SceneSnapshot.h"
+
+#include "Engine/ECS/Core/EntityManager.h"
+
+namespace Ares::ECS {
+
+	namespace {
+
+		using Reader = SceneSerializer::Reader;
+		using Writer = SceneSerializer::Writer;
+
+		// Zero runs shorter than this are cheaper to keep inside a literal run
+		constexpr size_t MinZeroRun = 3;
+
+		// LEB128 variable-length integers
+		void WriteVarint(Writer& writer, uint64_t value)
+		{
+			uint8_t bytes[10];
+			size_t count = 0;
+			do
+			{
+				bytes[count] = static_cast<uint8_t>(value & 0x7F);
+				value >>= 7;
+				if (value != 0)
+					bytes[count] |= 0x80;
+				count++;
+			} while (value != 0);
+			writer.Write(bytes, count);
+		}
+
+		bool ReadVarint(Reader& reader, uint64_t& value)
+		{
+			value = 0;
+			for (uint32_t shift = 0; shift < 64; shift += 7)
+			{
+				uint8_t byte = 0;
+				if (!reader.Read(byte))
+					return false;
+
+				value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+					return true;
+			}
+			return false;
+		}
+
+		bool ReadVarint(Reader& reader, uint32_t& value)
+		{
+			uint64_t wide = 0;
+			if (!ReadVarint(reader, wide) || wide > std::numeric_limits<uint32_t>::max())
+				return false;
+
+			value = static_cast<uint32_t>(wide);
+			return true;
+		}
+
+		// FNV-1a of the base bytes of XOR encoded components, stable across builds & platforms
+		uint64_t HashBytes(const uint8_t* data, const size_t size)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= data[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		// Run-length encoding as pairs of runs: (zero count, literal count, literal bytes)
+		void WriteRuns(Writer& writer, const uint8_t* data, const size_t size)
+		{
+			size_t i = 0;
+			while (i < size)
+			{
+				const size_t zeroStart = i;
+				while (i < size && data[i] == 0)
+					i++;
+
+				// Literals last until the next long enough zero run
+				const size_t literalStart = i;
+				while (i < size)
+				{
+					if (data[i] != 0)
+					{
+						i++;
+						continue;
+					}
+
+					size_t end = i;
+					while (end < size && data[end] == 0 && end - i < MinZeroRun)
+						end++;
+					if (end - i == MinZeroRun || end == size)
+						break;
+					i = end;
+				}
+
+				WriteVarint(writer, literalStart - zeroStart);
+				WriteVarint(writer, i - literalStart);
+				writer.Write(data + literalStart, i - literalStart);
+			}
+		}
+
+		bool ReadRuns(Reader& reader, uint8_t* destination, const size_t size)
+		{
+			std::memset(destination, 0, size);
+			size_t i = 0;
+			while (i < size)
+			{
+				uint64_t zeroCount = 0;
+				uint64_t literalCount = 0;
+				if (!ReadVarint(reader, zeroCount) || !ReadVarint(reader, literalCount))
+					return false;
+				if (zeroCount + literalCount == 0 || zeroCount > size - i || literalCount > size - i - zeroCount)
+					return false;
+
+				i += zeroCount;
+				if (!reader.Read(destination + i, literalCount))
+					return false;
+				i += literalCount;
+			}
+			return true;
+		}
+
+	}
+
+	SceneSnapshot SceneSnapshot::Capture(EntityManager* entityManager)
+	{
+		SceneSerializer::RegisterDefaultComponents();
+
+		SceneSnapshot snapshot;
+		Writer writer(snapshot.m_Data);
+		std::vector<std::pair<size_t, const SceneSerializer::SerializedComponent*>> columns;
+		{
+			std::shared_lock lock(entityManager->m_ComponentMutex);
+			for (const Scope<Archetype>& archetype : entityManager->m_Archetypes)
+			{
+				if (archetype->GetEntityCount() == 0)
+					continue;
+
+				// Registered components, in name order
+				columns.clear();
+				for (size_t column = 0; column < archetype->GetSignature().size(); column++)
+				{
+					const SceneSerializer::SerializedComponent* component = SceneSerializer::FindComponent(archetype->GetSignature()[column]);
+					if (component != nullptr)
+						columns.emplace_back(column, component);
+				}
+				std::sort(columns.begin(), columns.end(), [](const auto& a, const auto& b) {
+					return a.second->NameHash < b.second->NameHash;
+				});
+
+				for (uint32_t row = 0; row < archetype->GetEntityCount(); row++)
+				{
+					snapshot.m_Entities.push_back({
+						archetype->GetEntity(row),
+						static_cast<uint32_t>(snapshot.m_Components.size()),
+						static_cast<uint32_t>(columns.size())
+					});
+
+					for (const auto& [column, component] : columns)
+					{
+						const size_t offset = snapshot.m_Data.size();
+						const void* data = archetype->GetComponent(row, column);
+						if (component->Write == nullptr)
+							writer.Write(data, component->Info->Size);
+						else
+							component->Write(data, writer);
+
+						snapshot.m_Components.push_back({
+							component->NameHash,
+							static_cast<uint32_t>(offset),
+							static_cast<uint32_t>(snapshot.m_Data.size() - offset)
+						});
+					}
+				}
+			}
+		}
+
+		std::sort(snapshot.m_Entities.begin(), snapshot.m_Entities.end(), [](const EntityState& a, const EntityState& b) {
+			return a.EntityId < b.EntityId;
+		});
+		return snapshot;
+	}
+
+	std::vector<uint8_t> SceneSnapshot::Diff(const SceneSnapshot& from, const SceneSnapshot& to)
+	{
+		return Encode(from, to, false);
+	}
+
+	std::vector<uint8_t> SceneSnapshot::Encode(const SceneSnapshot& from, const SceneSnapshot& to, const bool resendRemapped)
+	{
+		SceneSerializer::RegisterDefaultComponents();
+
+		// Components are referred to by their index in the delta's name table
+		std::vector<uint64_t> names;
+		std::unordered_map<uint64_t, uint32_t> nameIndices;
+		auto getNameIndex = [&names, &nameIndices](const uint64_t nameHash) {
+			auto [it, inserted] = nameIndices.try_emplace(nameHash, static_cast<uint32_t>(names.size()));
+			if (inserted)
+				names.push_back(nameHash);
+			return it->second;
+		};
+
+		std::vector<uint8_t> destroyedData, entityData, componentData, runData, xorData;
+		Writer destroyedWriter(destroyedData);
+		Writer entityWriter(entityData);
+		Writer componentWriter(componentData);
+		uint32_t destroyedCount = 0, entityCount = 0;
+		uint32_t previousDestroyed = 0, previousEntity = 0;
+
+		// XOR encoded components are followed by the hash of their base bytes
+		auto writeComponent = [&](const uint64_t nameHash, const ComponentEncoding encoding, const uint8_t* data, const size_t size, const uint64_t baseHash = 0) {
+			runData.clear();
+			Writer runWriter(runData);
+			WriteRuns(runWriter, data, size);
+
+			WriteVarint(componentWriter, getNameIndex(nameHash));
+			componentWriter.Write(encoding);
+			if (encoding == ComponentEncoding::Xor)
+				componentWriter.Write(baseHash);
+			WriteVarint(componentWriter, size);
+			WriteVarint(componentWriter, runData.size());
+			componentWriter.Write(runData.data(), runData.size());
+		};
+
+		std::vector<uint32_t> removed;
+		auto writeEntity = [&](const uint32_t entityId, const uint8_t flags, const uint32_t componentCount) {
+			if (flags == 0 && removed.empty() && componentCount == 0)
+				return;
+
+			WriteVarint(entityWriter, entityId - previousEntity);
+			entityWriter.Write(flags);
+			WriteVarint(entityWriter, removed.size());
+			for (const uint32_t nameIndex : removed)
+				WriteVarint(entityWriter, nameIndex);
+			WriteVarint(entityWriter, componentCount);
+			entityWriter.Write(componentData.data(), componentData.size());
+
+			previousEntity = entityId;
+			entityCount++;
+		};
+
+		// Both entity lists are sorted by id, so walk them side by side
+		size_t i = 0, j = 0;
+		while (i < from.m_Entities.size() || j < to.m_Entities.size())
+		{
+			const EntityState* before = i < from.m_Entities.size() ? &from.m_Entities[i] : nullptr;
+			const EntityState* after = j < to.m_Entities.size() ? &to.m_Entities[j] : nullptr;
+
+			if (after == nullptr || (before != nullptr && before->EntityId < after->EntityId))
+			{
+				WriteVarint(destroyedWriter, before->EntityId - previousDestroyed);
+				previousDestroyed = before->EntityId;
+				destroyedCount++;
+				i++;
+				continue;
+			}
+
+			removed.clear();
+			componentData.clear();
+			uint32_t componentCount = 0;
+
+			if (before == nullptr || after->EntityId < before->EntityId)
+			{
+				for (uint32_t c = 0; c < after->ComponentCount; c++)
+				{
+					const ComponentState& component = to.m_Components[after->FirstComponent + c];
+					writeComponent(component.NameHash, ComponentEncoding::Full, to.GetData(component), component.Size);
+				}
+				writeEntity(after->EntityId, EntityCreated, after->ComponentCount);
+				j++;
+				continue;
+			}
+
+			// Same entity in both, walk the components (sorted by name hash) side by side
+			uint32_t b = 0, a = 0;
+			while (b < before->ComponentCount || a < after->ComponentCount)
+			{
+				const ComponentState* oldComponent = b < before->ComponentCount ? &from.m_Components[before->FirstComponent + b] : nullptr;
+				const ComponentState* newComponent = a < after->ComponentCount ? &to.m_Components[after->FirstComponent + a] : nullptr;
+
+				if (newComponent == nullptr || (oldComponent != nullptr && oldComponent->NameHash < newComponent->NameHash))
+				{
+					removed.push_back(getNameIndex(oldComponent->NameHash));
+					b++;
+					continue;
+				}
+
+				if (oldComponent == nullptr || newComponent->NameHash < oldComponent->NameHash)
+				{
+					writeComponent(newComponent->NameHash, ComponentEncoding::Full, to.GetData(*newComponent), newComponent->Size);
+					componentCount++;
+					a++;
+					continue;
+				}
+
+				// Components holding entity ids are remapped after loading, so their live bytes
+				// don't match the snapshot and can't be the base of an XOR
+				const SceneSerializer::SerializedComponent* registered = SceneSerializer::FindComponent(newComponent->NameHash);
+				const bool remapped = registered == nullptr || registered->Remap != nullptr;
+
+				const uint8_t* oldData = from.GetData(*oldComponent);
+				const uint8_t* newData = to.GetData(*newComponent);
+				if ((resendRemapped && remapped) || oldComponent->Size != newComponent->Size || std::memcmp(oldData, newData, newComponent->Size) != 0)
+				{
+					if (oldComponent->Size == newComponent->Size && !remapped)
+					{
+						xorData.resize(newComponent->Size);
+						for (size_t k = 0; k < xorData.size(); k++)
+							xorData[k] = oldData[k] ^ newData[k];
+						writeComponent(newComponent->NameHash, ComponentEncoding::Xor, xorData.data(), xorData.size(), HashBytes(oldData, oldComponent->Size));
+					}
+					else
+					{
+						writeComponent(newComponent->NameHash, ComponentEncoding::Full, newData, newComponent->Size);
+					}
+					componentCount++;
+				}
+				b++;
+				a++;
+			}
+
+			writeEntity(after->EntityId, 0, componentCount);
+			i++;
+			j++;
+		}
+
+		std::vector<uint8_t> buffer;
+		Writer writer(buffer);
+		writer.Write(DeltaHeader{ DeltaMagic, DeltaVersion });
+		WriteVarint(writer, names.size());
+		for (const uint64_t nameHash : names)
+			writer.Write(nameHash);
+		WriteVarint(writer, destroyedCount);
+		writer.Write(destroyedData.data(), destroyedData.size());
+		WriteVarint(writer, entityCount);
+		writer.Write(entityData.data(), entityData.size());
+		return buffer;
+	}
+
+	bool SceneSnapshot::ApplyDelta(EntityManager* entityManager, const uint8_t* data, const size_t size, EntityMap& entityMap)
+	{
+		SceneSerializer::RegisterDefaultComponents();
+
+		Reader reader(data, size);
+		DeltaHeader header;
+		if (!reader.Read(header) || header.Magic != DeltaMagic || header.Version != DeltaVersion)
+		{
+			AR_CORE_WARN("Invalid scene delta!");
+			return false;
+		}
+
+		uint32_t nameCount = 0;
+		if (!ReadVarint(reader, nameCount) || reader.GetRemaining() / sizeof(uint64_t) < nameCount)
+			return false;
+
+		std::vector<const SceneSerializer::SerializedComponent*> components(nameCount);
+		for (uint32_t i = 0; i < nameCount; i++)
+		{
+			uint64_t nameHash = 0;
+			reader.Read(nameHash);
+			components[i] = SceneSerializer::FindComponent(nameHash);
+			if (components[i] == nullptr)
+				AR_CORE_WARN("Skipping unregistered component in scene delta!");
+		}
+
+		auto getEntity = [&entityMap](const uint32_t entityId) {
+			auto it = entityMap.find(entityId);
+			return it != entityMap.end() ? it->second : entityId;
+		};
+
+		// Components of one entity, decoded into one buffer
+		struct DecodedComponent
+		{
+			const SceneSerializer::SerializedComponent* Component;
+			ComponentEncoding Encoding;
+			uint64_t BaseHash;
+			size_t Offset;
+			size_t Size;
+		};
+		std::vector<DecodedComponent> decoded;
+		std::vector<uint8_t> decodedData;
+		std::vector<uint8_t> liveData;
+		std::vector<uint32_t> removed;
+
+		// Construct a component from its full bytes
+		auto construct = [](const DecodedComponent& component, void* destination, const uint8_t* bytes) {
+			if (component.Component->Read == nullptr)
+			{
+				std::memcpy(destination, bytes, component.Size);
+				return true;
+			}
+
+			Reader componentReader(bytes, component.Size);
+			return component.Component->Read(destination, componentReader);
+		};
+
+		std::vector<uint32_t> destroyedEntities;
+		std::vector<std::pair<uint32_t, const SceneSerializer::SerializedComponent*>> remaps;
+		bool result = true;
+
+		// Changes from the delta get their own change tick
+		entityManager->AdvanceChangeTick();
+		{
+			std::unique_lock lock(entityManager->m_ComponentMutex);
+			const uint32_t changeTick = entityManager->m_ChangeTick;
+
+			auto apply = [&]() {
+				uint32_t destroyedCount = 0;
+				if (!ReadVarint(reader, destroyedCount))
+					return false;
+
+				uint32_t entityId = 0;
+				for (uint32_t i = 0; i < destroyedCount; i++)
+				{
+					uint32_t idDelta = 0;
+					if (!ReadVarint(reader, idDelta))
+						return false;
+
+					entityId += idDelta;
+					const uint32_t liveId = getEntity(entityId);
+					if (entityManager->DestroyEntityRecord(liveId))
+						destroyedEntities.push_back(liveId);
+					entityMap.erase(entityId);
+				}
+
+				uint32_t entityCount = 0;
+				if (!ReadVarint(reader, entityCount))
+					return false;
+
+				entityId = 0;
+				for (uint32_t i = 0; i < entityCount; i++)
+				{
+					uint32_t idDelta = 0;
+					uint8_t flags = 0;
+					uint32_t removedCount = 0;
+					if (!ReadVarint(reader, idDelta) || !reader.Read(flags) || !ReadVarint(reader, removedCount))
+						return false;
+					entityId += idDelta;
+
+					removed.resize(removedCount);
+					for (uint32_t& nameIndex : removed)
+					{
+						if (!ReadVarint(reader, nameIndex) || nameIndex >= nameCount)
+							return false;
+					}
+
+					uint32_t componentCount = 0;
+					if (!ReadVarint(reader, componentCount))
+						return false;
+
+					decoded.clear();
+					decodedData.clear();
+					for (uint32_t c = 0; c < componentCount; c++)
+					{
+						uint32_t nameIndex = 0;
+						ComponentEncoding encoding = ComponentEncoding::Full;
+						uint64_t baseHash = 0;
+						uint64_t componentSize = 0;
+						uint64_t encodedSize = 0;
+						if (!ReadVarint(reader, nameIndex) || nameIndex >= nameCount || !reader.Read(encoding) ||
+							(encoding != ComponentEncoding::Full && encoding != ComponentEncoding::Xor) ||
+							(encoding == ComponentEncoding::Xor && !reader.Read(baseHash)) ||
+							!ReadVarint(reader, componentSize) || !ReadVarint(reader, encodedSize) || encodedSize > reader.GetRemaining())
+							return false;
+
+						Reader runReader(reader.GetPosition(), static_cast<size_t>(encodedSize));
+						reader.Skip(static_cast<size_t>(encodedSize));
+
+						const SceneSerializer::SerializedComponent* component = components[nameIndex];
+						if (component == nullptr)
+							continue;
+						if (component->Read == nullptr && componentSize != component->Info->Size)
+						{
+							AR_CORE_WARN("Skipping component with a different size than the one in the scene delta!");
+							result = false;
+							continue;
+						}
+
+						const size_t offset = decodedData.size();
+						decodedData.resize(offset + static_cast<size_t>(componentSize));
+						if (!ReadRuns(runReader, decodedData.data() + offset, static_cast<size_t>(componentSize)))
+							return false;
+						decoded.push_back({ component, encoding, baseHash, offset, static_cast<size_t>(componentSize) });
+					}
+
+					uint32_t liveId = 0;
+					if (flags & EntityCreated)
+					{
+						// Create the entity straight in its final archetype
+						std::vector<const ComponentInfo*> infos;
+						std::erase_if(decoded, [&infos](const DecodedComponent& component) {
+							if (component.Encoding != ComponentEncoding::Full || std::find(infos.begin(), infos.end(), component.Component->Info) != infos.end())
+								return true;
+							infos.push_back(component.Component->Info);
+							return false;
+						});
+
+						Archetype* archetype = entityManager->GetOrCreateArchetype(infos);
+						liveId = entityManager->CreateEntityRecord(archetype);
+						if (liveId == EntityID::Invalid)
+						{
+							result = false;
+							continue;
+						}
+						entityMap[entityId] = liveId;
+
+						const EntityManager::EntityRecord* record = entityManager->FindRecord(liveId);
+						for (const DecodedComponent& component : decoded)
+						{
+							const size_t column = static_cast<size_t>(archetype->GetColumnIndex(component.Component->Info->Type));
+							result &= construct(component, archetype->GetComponent(record->Row, column), decodedData.data() + component.Offset);
+							archetype->MarkAdded(record->Row, column, changeTick);
+						}
+					}
+					else
+					{
+						liveId = getEntity(entityId);
+						if (entityManager->FindRecord(liveId) == nullptr)
+						{
+							AR_CORE_WARN("Scene delta changes an entity that doesn't exist!");
+							result = false;
+							continue;
+						}
+
+						for (const uint32_t nameIndex : removed)
+						{
+							if (components[nameIndex] != nullptr)
+								entityManager->EraseComponent(liveId, *components[nameIndex]->Info);
+						}
+
+						for (const DecodedComponent& component : decoded)
+						{
+							const ComponentInfo& info = *component.Component->Info;
+							uint8_t* bytes = decodedData.data() + component.Offset;
+
+							const EntityManager::EntityRecord* record = entityManager->FindRecord(liveId);
+							const int32_t column = record->Storage->GetColumnIndex(info.Type);
+							if (column < 0)
+							{
+								if (component.Encoding != ComponentEncoding::Full)
+								{
+									AR_CORE_WARN("Scene delta changes a component that doesn't exist!");
+									result = false;
+									continue;
+								}
+								result &= construct(component, entityManager->EmplaceComponent(liveId, info), bytes);
+								continue;
+							}
+
+							void* destination = record->Storage->GetComponent(record->Row, column);
+							if (component.Encoding == ComponentEncoding::Xor)
+							{
+								// XOR against the live component
+								const uint8_t* liveBytes = static_cast<const uint8_t*>(destination);
+								size_t liveSize = info.Size;
+								if (component.Component->Write != nullptr)
+								{
+									liveData.clear();
+									Writer liveWriter(liveData);
+									component.Component->Write(destination, liveWriter);
+									liveBytes = liveData.data();
+									liveSize = liveData.size();
+								}
+
+								// The live component has to be the delta's base, anything else would come out as garbage
+								if (liveSize != component.Size || HashBytes(liveBytes, liveSize) != component.BaseHash)
+								{
+									AR_CORE_WARN("Scene delta doesn't match the component it changes!");
+									result = false;
+									continue;
+								}
+								for (size_t k = 0; k < component.Size; k++)
+									bytes[k] ^= liveBytes[k];
+							}
+
+							info.Destroy(destination);
+							result &= construct(component, destination, bytes);
+							record->Storage->MarkChanged(record->Row / record->Storage->GetChunkCapacity(), column, changeTick);
+						}
+					}
+
+					for (const DecodedComponent& component : decoded)
+					{
+						if (component.Component->Remap != nullptr)
+							remaps.emplace_back(liveId, component.Component);
+					}
+				}
+
+				return true;
+			};
+			if (!apply())
+			{
+				AR_CORE_WARN("Scene delta is corrupted, stopped applying it!");
+				result = false;
+			}
+
+			// Map the entity ids held by components, ids that weren't recreated stay as they are
+			const SceneSerializer::EntityRemap remap = { entityMap, true };
+			for (const auto& [liveId, component] : remaps)
+			{
+				const EntityManager::EntityRecord* record = entityManager->FindRecord(liveId);
+				const int32_t column = record != nullptr ? record->Storage->GetColumnIndex(component->Info->Type) : -1;
+				if (column >= 0)
+					component->Remap(record->Storage->GetComponent(record->Row, column), remap);
+			}
+		}
+
+		for (const uint32_t destroyedId : destroyedEntities)
+			entityManager->ClearEntityName(destroyedId);
+
+		return result;
+	}
+
+	bool SceneSnapshot::Restore(EntityManager* entityManager, const SceneSnapshot& snapshot, EntityMap& entityMap)
+	{
+		// Refer to entities recreated by earlier restores by their snapshot ids, so they aren't recreated again
+		SceneSnapshot current = Capture(entityManager);
+		if (!entityMap.empty())
+		{
+			std::unordered_map<uint32_t, uint32_t> snapshotIds;
+			for (const auto& [snapshotId, liveId] : entityMap)
+				snapshotIds[liveId] = snapshotId;
+
+			for (EntityState& entity : current.m_Entities)
+			{
+				auto it = snapshotIds.find(entity.EntityId);
+				if (it != snapshotIds.end())
+					entity.EntityId = it->second;
+			}
+			std::sort(current.m_Entities.begin(), current.m_Entities.end(), [](const EntityState& a, const EntityState& b) {
+				return a.EntityId < b.EntityId;
+			});
+		}
+
+		// Unchanged components can still refer to entities the delta recreates, so resend every remapped one
+		const std::vector<uint8_t> delta = Encode(current, snapshot, true);
+		return ApplyDelta(entityManager, delta.data(), delta.size(), entityMap);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+#include "Engine/ECS/Core/SceneSerializer.h"
+
+namespace Ares::ECS {
+
+	class EntityManager;
+
+	// In-memory copy of the registered components (see SceneSerializer) of every entity,
+	// used for save-states and as the two ends of a scene delta.
+	//
+	// A delta holds the entities destroyed & created between two snapshots and the components
+	// added, removed or changed on the others. Changed components are stored as the XOR of their
+	// old and new bytes, so every untouched byte turns into a zero run that the run-length
+	// encoding collapses. They also carry a hash of the old bytes, a changed component whose live
+	// bytes don't match it is rejected instead of being XORed into garbage. Ids, counts and sizes
+	// are written as variable-length integers, with entity ids delta coded against the previous one.
+	class SceneSnapshot
+	{
+	public:
+		// Map from the entity ids of snapshots to the ids of the entities in a live entity manager
+		using EntityMap = std::unordered_map<uint32_t, uint32_t>;
+
+		static constexpr uint32_t DeltaMagic = 0x4C445241; // "ARDL"
+		static constexpr uint32_t DeltaVersion = 2;
+
+	public:
+		// Copy every entity with its registered components
+		static SceneSnapshot Capture(EntityManager* entityManager);
+
+		// Encode the changes turning from into to
+		static std::vector<uint8_t> Diff(const SceneSnapshot& from, const SceneSnapshot& to);
+		// Apply a delta to an entity manager in the delta's from state. Ids missing from entityMap are
+		// used as they are (deltas between snapshots of the same entity manager), entities created by
+		// the delta are added to it and destroyed ones are removed.
+		static bool ApplyDelta(EntityManager* entityManager, const uint8_t* data, const size_t size, EntityMap& entityMap);
+		// Bring an entity manager back to the state of a snapshot taken from it
+		static bool Restore(EntityManager* entityManager, const SceneSnapshot& snapshot, EntityMap& entityMap);
+
+		inline size_t GetEntityCount() const { return m_Entities.size(); }
+		inline size_t GetDataSize() const { return m_Data.size(); }
+
+	private:
+		struct EntityState
+		{
+			uint32_t EntityId;
+			uint32_t FirstComponent;
+			uint32_t ComponentCount;
+		};
+
+		struct ComponentState
+		{
+			uint64_t NameHash;
+			uint32_t Offset;
+			uint32_t Size;
+		};
+
+		struct DeltaHeader
+		{
+			uint32_t Magic;
+			uint32_t Version;
+		};
+
+		enum class ComponentEncoding : uint8_t
+		{
+			Full = 0,
+			Xor = 1
+		};
+
+		enum EntityFlags : uint8_t
+		{
+			EntityCreated = 1 << 0
+		};
+
+		static std::vector<uint8_t> Encode(const SceneSnapshot& from, const SceneSnapshot& to, const bool resendRemapped);
+
+		inline const uint8_t* GetData(const ComponentState& component) const { return m_Data.data() + component.Offset; }
+
+	private:
+		// Sorted by entity id
+		std::vector<EntityState> m_Entities;
+		// Each entity's components are sorted by name hash
+		std::vector<ComponentState> m_Components;
+		std::vector<uint8_t> m_Data;
+	};
+
+}
\ No newline at end of file
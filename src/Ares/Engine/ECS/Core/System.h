@@ -1,4 +1,5 @@
 #pragma once
+#include "Engine/ECS/Core/ComponentInfo.h"
 
 namespace Ares {
 
@@ -8,6 +9,20 @@ namespace Ares {
 
 		class Scene;
 
+		// Component access declared by a system, used by the scene to decide which
+		// systems can be updated at the same time
+		struct SystemAccess
+		{
+			std::vector<ComponentTypeID> Reads;
+			std::vector<ComponentTypeID> Writes;
+			// Systems that declare nothing are treated as touching everything
+			bool Declared = false;
+			// Systems that have to be updated on the main thread (e.g. because they use the graphics API)
+			bool MainThread = false;
+
+			bool ConflictsWith(const SystemAccess& other) const;
+		};
+
 		class System
 		{
 		public:
@@ -22,10 +37,68 @@ namespace Ares {
 			// Called every OnUpdate
 			virtual void OnUpdate(const Scene& scene, const Timestep& timestep) = 0;
 
-			// Called every OnRender
+			// Called every OnRender. Command buffers are only played back afterwards, but component
+			// pointers from OnUpdate shouldn't be kept: code outside the scene can still change it in between
 			virtual void OnRender(const Scene& scene) {}
+
+			// Getter for the declared component access
+			inline const SystemAccess& GetAccess() const { return m_Access; }
+
+		protected:
+			// Declare component access (call from the system's constructor)
+			template <typename... ECSComponents>
+			void Reads();
+			template <typename... ECSComponents>
+			void Writes();
+			void RunOnMainThread();
+
+			// Change tick of the system's previous update, for Changed<T> & Added<T> query filters
+			inline uint32_t GetLastRunTick() const { return m_LastRunTick; }
+
+		private:
+			SystemAccess m_Access;
+			uint32_t m_LastRunTick = 0;
+
+			friend class SystemScheduler;
 		};
 
+		template <typename... ECSComponents>
+		inline void System::Reads()
+		{
+			m_Access.Declared = true;
+			(m_Access.Reads.push_back(GetComponentTypeID<ECSComponents>()), ...);
+		}
+
+		template <typename... ECSComponents>
+		inline void System::Writes()
+		{
+			m_Access.Declared = true;
+			(m_Access.Writes.push_back(GetComponentTypeID<ECSComponents>()), ...);
+		}
+
+		inline void System::RunOnMainThread()
+		{
+			m_Access.MainThread = true;
+		}
+
+		inline bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+		{
+			if (!Declared || !other.Declared)
+				return true;
+
+			auto overlaps = [](const std::vector<ComponentTypeID>& a, const std::vector<ComponentTypeID>& b) {
+				for (const ComponentTypeID type : a)
+				{
+					if (std::find(b.begin(), b.end(), type) != b.end())
+						return true;
+				}
+				return false;
+			};
+
+			// Two systems conflict if either one writes something the other one touches
+			return overlaps(Writes, other.Writes) || overlaps(Writes, other.Reads) || overlaps(Reads, other.Writes);
+		}
+
 	}
 
 }
\ No newline at end of file
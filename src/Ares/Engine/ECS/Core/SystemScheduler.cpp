@@ -0,0 +1,88 @@
+#include <arespch.h>
+#include "Engine/ECS/Core/SystemScheduler.h"
+
+#include "Engine/Core/ThreadPool.h"
+#include "Engine/ECS/Core/EntityManager.h"
+#include "Engine/ECS/Core/Scene.h"
+#include "Engine/ECS/Core/System.h"
+
+namespace Ares::ECS {
+
+	void SystemScheduler::Build(const std::vector<System*>& systems)
+	{
+		m_Stages.clear();
+		std::vector<size_t> systemStages;
+		systemStages.reserve(systems.size());
+
+		for (size_t i = 0; i < systems.size(); i++)
+		{
+			// A system goes in the stage after the last earlier system it conflicts with
+			size_t stage = 0;
+			for (size_t j = 0; j < i; j++)
+			{
+				if (systems[i]->GetAccess().ConflictsWith(systems[j]->GetAccess()))
+					stage = std::max(stage, systemStages[j] + 1);
+			}
+
+			systemStages.push_back(stage);
+			if (stage >= m_Stages.size())
+				m_Stages.resize(stage + 1);
+			m_Stages[stage].push_back(systems[i]);
+		}
+	}
+
+	void SystemScheduler::Run(const Scene& scene, const Timestep& timestep) const
+	{
+		std::vector<std::future<void>> tasks;
+		std::vector<System*> mainThreadSystems;
+
+		for (const std::vector<System*>& stage : m_Stages)
+		{
+			tasks.clear();
+			mainThreadSystems.clear();
+
+			// Every stage gets its own change tick, so systems see the writes of every other stage
+			const uint32_t changeTick = scene.GetEntityManager()->AdvanceChangeTick();
+
+			for (System* system : stage)
+			{
+				if (system->GetAccess().MainThread)
+					mainThreadSystems.push_back(system);
+			}
+
+			// Hand the worker systems to the thread pool, keeping one for this thread if it would otherwise idle
+			System* localSystem = nullptr;
+			for (System* system : stage)
+			{
+				if (system->GetAccess().MainThread)
+					continue;
+
+				if (mainThreadSystems.empty() && localSystem == nullptr)
+				{
+					localSystem = system;
+					continue;
+				}
+
+				tasks.push_back(ThreadPool::SubmitTask([system, &scene, &timestep]() {
+					system->OnUpdate(scene, timestep);
+				}));
+			}
+
+			for (System* system : mainThreadSystems)
+				system->OnUpdate(scene, timestep);
+			if (localSystem != nullptr)
+				localSystem->OnUpdate(scene, timestep);
+
+			// Sync point between stages
+			for (std::future<void>& task : tasks)
+				task.get();
+
+			for (System* system : stage)
+				system->m_LastRunTick = changeTick;
+		}
+
+		// Writes made between updates (outside any system) have to be newer than every system's last run
+		scene.GetEntityManager()->AdvanceChangeTick();
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+namespace Ares {
+
+	class Timestep;
+
+	namespace ECS {
+
+		class Scene;
+		class System;
+
+		// Groups systems into stages using their declared component access.
+		// Systems inside a stage don't conflict and are updated in parallel on the thread pool,
+		// stages run one after another. Conflicting systems keep their relative order.
+		class SystemScheduler
+		{
+		public:
+			// Build the stages from an ordered list of systems
+			void Build(const std::vector<System*>& systems);
+
+			// Update every system, stage by stage
+			void Run(const Scene& scene, const Timestep& timestep) const;
+
+			inline const std::vector<std::vector<System*>>& GetStages() const { return m_Stages; }
+
+		private:
+			std::vector<std::vector<System*>> m_Stages;
+		};
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+#pragma once
+#include "Engine/ECS/Core/Archetype.h"
+
+namespace Ares::ECS {
+
+	// Query filters, passing entities whose component was written (Changed) or added (Added)
+	// after the given tick. Change tracking is per chunk, so a filter may also pass unchanged
+	// entities that share a chunk with changed ones.
+	template <typename ECSComponent>
+	struct Changed
+	{
+		using Type = ECSComponent;
+		static constexpr bool IsAdded = false;
+	};
+
+	template <typename ECSComponent>
+	struct Added
+	{
+		using Type = ECSComponent;
+		static constexpr bool IsAdded = true;
+	};
+
+	// A typed view over every entity that has all of the requested components.
+	// Views keep a snapshot of the matching archetype list of a cached query owned by the entity
+	// manager, so iterating only touches matching entities and needs no per-entity lookups.
+	// Archetypes created after the view won't be visited, so don't keep views across structural changes.
+	//
+	// Iterating marks the chunks of every non-const component as changed.
+	// Each and EachChunk hold the entity manager's component lock (shared) while the callbacks
+	// run. That lock isn't recursive, so callbacks must not call back into the entity manager
+	// (GetComponent, Query, Size, adding or removing components or entities): collect the entity
+	// ids and touch them after the loop, or record structural changes in a command buffer.
+	template <typename... ECSComponents>
+	class View
+	{
+	public:
+		static_assert(sizeof...(ECSComponents) > 0, "A view needs at least one component type!");
+
+		View(Ref<const std::vector<Archetype*>> archetypes, std::shared_mutex& mutex, const uint32_t& changeTick)
+			: m_Archetypes(std::move(archetypes)), m_Mutex(&mutex), m_ChangeTick(&changeTick)
+		{
+		}
+
+		// Returns a copy of the view that only visits chunks passing every filter (Changed<T> or Added<T>) since the tick
+		template <typename... Filters>
+		View Where(const uint32_t sinceTick) const;
+
+		// Calls func(entityId, ECSComponents&...) for every matching entity, under the component lock
+		template <typename Func>
+		void Each(Func&& func) const;
+
+		// Calls func(count, entityIds, ECSComponents*...) once per chunk with the chunk's tightly packed arrays,
+		// under the component lock
+		template <typename Func>
+		void EachChunk(Func&& func) const;
+
+		// Number of matching entities
+		size_t Size() const;
+
+		inline const std::vector<Archetype*>& GetArchetypes() const { return *m_Archetypes; }
+
+	private:
+		// Filter resolved against one archetype
+		struct Filter
+		{
+			ComponentTypeID Type;
+			bool IsAdded;
+		};
+		static constexpr size_t MaxFilters = 4;
+
+		// Returns false if the archetype can't pass the filters, otherwise fills in the filter columns
+		bool ResolveFilters(const Archetype* archetype, std::array<int32_t, MaxFilters>& columns) const;
+		bool PassesFilters(const Archetype* archetype, const size_t chunk, const std::array<int32_t, MaxFilters>& columns) const;
+		template <size_t... Indices>
+		void MarkChanged(Archetype* archetype, const size_t chunk, const std::array<size_t, sizeof...(ECSComponents)>& columns, std::index_sequence<Indices...>) const;
+
+		template <typename Func, size_t... Indices>
+		void EachInArchetype(Archetype* archetype, Func& func, std::index_sequence<Indices...>) const;
+		template <typename Func, size_t... Indices>
+		void EachChunkInArchetype(Archetype* archetype, Func& func, std::index_sequence<Indices...>) const;
+
+	private:
+		Ref<const std::vector<Archetype*>> m_Archetypes;
+		std::shared_mutex* m_Mutex;
+		const uint32_t* m_ChangeTick;
+		std::array<Filter, MaxFilters> m_Filters = {};
+		size_t m_FilterCount = 0;
+		uint32_t m_SinceTick = 0;
+	};
+
+	template <typename... ECSComponents>
+	template <typename... Filters>
+	inline View<ECSComponents...> View<ECSComponents...>::Where(const uint32_t sinceTick) const
+	{
+		static_assert(sizeof...(Filters) <= MaxFilters, "Too many filters in one view!");
+
+		View result = *this;
+		result.m_Filters = { Filter{ GetComponentTypeID<typename Filters::Type>(), Filters::IsAdded }... };
+		result.m_FilterCount = sizeof...(Filters);
+		result.m_SinceTick = sinceTick;
+		return result;
+	}
+
+	template <typename... ECSComponents>
+	template <typename Func>
+	inline void View<ECSComponents...>::Each(Func&& func) const
+	{
+		std::shared_lock<std::shared_mutex> lock(*m_Mutex);
+		for (Archetype* archetype : *m_Archetypes)
+		{
+			if (archetype->GetEntityCount() > 0)
+				EachInArchetype(archetype, func, std::index_sequence_for<ECSComponents...>{});
+		}
+	}
+
+	template <typename... ECSComponents>
+	template <typename Func>
+	inline void View<ECSComponents...>::EachChunk(Func&& func) const
+	{
+		std::shared_lock<std::shared_mutex> lock(*m_Mutex);
+		for (Archetype* archetype : *m_Archetypes)
+		{
+			if (archetype->GetEntityCount() > 0)
+				EachChunkInArchetype(archetype, func, std::index_sequence_for<ECSComponents...>{});
+		}
+	}
+
+	template <typename... ECSComponents>
+	inline size_t View<ECSComponents...>::Size() const
+	{
+		std::shared_lock<std::shared_mutex> lock(*m_Mutex);
+		size_t result = 0;
+		std::array<int32_t, MaxFilters> filterColumns;
+		for (Archetype* archetype : *m_Archetypes)
+		{
+			if (m_FilterCount == 0)
+			{
+				result += archetype->GetEntityCount();
+				continue;
+			}
+
+			if (!ResolveFilters(archetype, filterColumns))
+				continue;
+			for (size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++)
+			{
+				if (PassesFilters(archetype, chunk, filterColumns))
+					result += archetype->GetChunkEntityCount(chunk);
+			}
+		}
+		return result;
+	}
+
+	template <typename... ECSComponents>
+	inline bool View<ECSComponents...>::ResolveFilters(const Archetype* archetype, std::array<int32_t, MaxFilters>& columns) const
+	{
+		for (size_t i = 0; i < m_FilterCount; i++)
+		{
+			columns[i] = archetype->GetColumnIndex(m_Filters[i].Type);
+			if (columns[i] < 0)
+				return false;
+		}
+		return true;
+	}
+
+	template <typename... ECSComponents>
+	inline bool View<ECSComponents...>::PassesFilters(const Archetype* archetype, const size_t chunk, const std::array<int32_t, MaxFilters>& columns) const
+	{
+		for (size_t i = 0; i < m_FilterCount; i++)
+		{
+			const uint32_t version = m_Filters[i].IsAdded
+				? archetype->GetAddedVersion(chunk, columns[i])
+				: archetype->GetChangedVersion(chunk, columns[i]);
+			if (version <= m_SinceTick)
+				return false;
+		}
+		return true;
+	}
+
+	template <typename... ECSComponents>
+	template <size_t... Indices>
+	inline void View<ECSComponents...>::MarkChanged(Archetype* archetype, const size_t chunk, const std::array<size_t, sizeof...(ECSComponents)>& columns, std::index_sequence<Indices...>) const
+	{
+		((std::is_const_v<ECSComponents> ? void() : archetype->MarkChanged(chunk, columns[Indices], *m_ChangeTick)), ...);
+	}
+
+	template <typename... ECSComponents>
+	template <typename Func, size_t... Indices>
+	inline void View<ECSComponents...>::EachInArchetype(Archetype* archetype, Func& func, std::index_sequence<Indices...>) const
+	{
+		// Resolve the column of every requested component once per archetype
+		const std::array<size_t, sizeof...(ECSComponents)> columns = {
+			static_cast<size_t>(archetype->GetColumnIndex(GetComponentTypeID<ECSComponents>()))...
+		};
+		std::array<int32_t, MaxFilters> filterColumns;
+		if (!ResolveFilters(archetype, filterColumns))
+			return;
+
+		for (size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++)
+		{
+			if (!PassesFilters(archetype, chunk, filterColumns))
+				continue;
+			MarkChanged(archetype, chunk, columns, std::index_sequence_for<ECSComponents...>{});
+
+			const size_t count = archetype->GetChunkEntityCount(chunk);
+			const uint32_t* entities = archetype->GetEntities(chunk);
+			std::tuple<ECSComponents*...> arrays = {
+				reinterpret_cast<ECSComponents*>(archetype->GetColumn(chunk, columns[Indices]))...
+			};
+
+			for (size_t i = 0; i < count; i++)
+				func(entities[i], std::get<Indices>(arrays)[i]...);
+		}
+	}
+
+	template <typename... ECSComponents>
+	template <typename Func, size_t... Indices>
+	inline void View<ECSComponents...>::EachChunkInArchetype(Archetype* archetype, Func& func, std::index_sequence<Indices...>) const
+	{
+		const std::array<size_t, sizeof...(ECSComponents)> columns = {
+			static_cast<size_t>(archetype->GetColumnIndex(GetComponentTypeID<ECSComponents>()))...
+		};
+		std::array<int32_t, MaxFilters> filterColumns;
+		if (!ResolveFilters(archetype, filterColumns))
+			return;
+
+		for (size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++)
+		{
+			if (!PassesFilters(archetype, chunk, filterColumns))
+				continue;
+			MarkChanged(archetype, chunk, columns, std::index_sequence_for<ECSComponents...>{});
+
+			const size_t count = archetype->GetChunkEntityCount(chunk);
+			func(
+				count,
+				static_cast<const uint32_t*>(archetype->GetEntities(chunk)),
+				reinterpret_cast<ECSComponents*>(archetype->GetColumn(chunk, columns[Indices]))...
+			);
+		}
+	}
+
+}
\ No newline at end of file
@@ -11,6 +11,8 @@ namespace Ares::ECS::Systems {
 	CameraSystem::CameraSystem()
 		: m_ViewportSize(1280.0f, 720.0f), m_ActiveCameraEntityId(0)
 	{
+		Reads<Components::Transform>();
+		Writes<Components::Camera>();
 	}
 
 	void CameraSystem::OnUpdate(const Scene& scene, const Timestep& timestep)
@@ -18,30 +20,25 @@ namespace Ares::ECS::Systems {
 		std::shared_lock<std::shared_mutex> lock(m_Mutex);
 		EntityManager* entityManager = scene.GetEntityManager();
 
-		// Query entities with Transform and Camera components
-		for (auto& entry : entityManager->GetEntityComponents())
-		{
-			const uint32_t entityId = entry.first;
-			Components::Camera* camera = entityManager->GetComponent<Components::Camera>(entityId);
-			if (camera != nullptr)
-			{
-				// Entity has camera - check if active
-				if (m_ActiveCameraEntityId == entityId)
-				{
-					// Update viewport
-					camera->SetViewportSize(m_ViewportSize);
+		// Only the active camera needs updating
+		const Components::Camera* camera = entityManager->GetComponent<const Components::Camera>(m_ActiveCameraEntityId);
+		if (camera == nullptr)
+			return;
 
-					// Update camera position and orientation
-					Components::Transform* transform = entityManager->GetComponent<Components::Transform>(entityId);
+		// The camera follows its transform's position and orientation, if it has one
+		const Components::Transform* transform = entityManager->GetComponent<const Components::Transform>(m_ActiveCameraEntityId);
+		const glm::vec3 position = transform != nullptr ? transform->GetPosition() : camera->GetPosition();
+		const glm::quat rotation = transform != nullptr ? transform->GetRotation() : camera->GetRotation();
 
-					if (transform)
-					{
-						camera->SetPosition(transform->GetPosition());
-						camera->SetRotation(transform->GetRotation());
-					}
-				}
-			}
-		}
+		// Only written when the view changed, so Changed<Camera> stays meaningful for its readers
+		if (!camera->IsDirty() && camera->GetViewportSize() == m_ViewportSize && camera->GetPosition() == position && camera->GetRotation() == rotation)
+			return;
+
+		Components::Camera* activeCamera = entityManager->GetComponent<Components::Camera>(m_ActiveCameraEntityId);
+		activeCamera->SetViewportSize(m_ViewportSize);
+		activeCamera->SetPosition(position);
+		activeCamera->SetRotation(rotation);
+		activeCamera->CalculateViewProjectionMatrix();
 	}
 
 	const uint32_t CameraSystem::GetActiveCameraEntityId()
@@ -0,0 +1,100 @@
+#include <arespch.h>
+#include "Engine/ECS/Systems/LODSystem.h"
+
+#include "Engine/Core/Timestep.h"
+#include "Engine/ECS/Components/AllComponents.h"
+#include "Engine/ECS/Core/EntityManager.h"
+#include "Engine/ECS/Core/Scene.h"
+#include "Engine/ECS/Systems/CameraSystem.h"
+
+namespace Ares::ECS::Systems {
+
+	LODSystem::LODSystem()
+	{
+		Reads<Components::Transform, Components::Camera>();
+		Writes<Components::Mesh>();
+	}
+
+	void LODSystem::OnUpdate(const Scene& scene, const Timestep& timestep)
+	{
+		EntityManager* entityManager = scene.GetEntityManager();
+		const Components::Camera* camera = entityManager->GetComponent<const Components::Camera>(scene.GetSystem<Systems::CameraSystem>()->GetActiveCameraEntityId());
+		if (camera == nullptr)
+			return;
+
+		// Projected size = radius * scale / distance (perspective) or radius * scale (orthographic)
+		const bool perspective = camera->GetMode() == Components::Camera::Perspective;
+		const float projectionScale = perspective
+			? 1.0f / std::tan(glm::radians(camera->GetPerspectiveFov()) * 0.5f)
+			: 1.0f / camera->GetOrthoZoom();
+		const glm::vec3 cameraPosition = camera->GetPosition();
+
+		auto selectLevels = [this, perspective, projectionScale, cameraPosition](const size_t count, const uint32_t* entities, const Components::Mesh* meshes, const Components::Transform* transforms) {
+			for (size_t i = 0; i < count; i++)
+			{
+				const Components::MeshLODChain* lodChain = meshes[i].GetLODChain().get();
+				if (lodChain == nullptr || lodChain->Levels.size() < 2)
+					continue;
+
+				const AABB bounds = meshes[i].GetBounds();
+				if (!bounds.IsValid())
+					continue;
+
+				const AABB worldBounds = bounds.Transformed(transforms[i].GetWorldMatrix());
+				const float radius = glm::length(worldBounds.GetExtents());
+				float screenSize = radius * projectionScale;
+				if (perspective)
+				{
+					// The camera inside the sphere always gets the most detailed level
+					const float distance = glm::length(worldBounds.GetCenter() - cameraPosition);
+					screenSize = distance > radius ? screenSize / distance : std::numeric_limits<float>::max();
+				}
+
+				const uint32_t currentLevel = meshes[i].GetLODLevel();
+				const uint32_t level = SelectLevel(*lodChain, currentLevel, screenSize);
+				if (level != currentLevel)
+					m_Switches.push_back({ entities[i], level });
+			}
+		};
+
+		// Projected sizes only change with the camera or the entity's transform (or mesh)
+		m_Switches.clear();
+		View<const Components::Mesh, const Components::Transform> meshes = entityManager->Query<const Components::Mesh, const Components::Transform>();
+		if (m_HasPendingLevels || cameraPosition != m_CameraPosition || projectionScale != m_ProjectionScale)
+		{
+			meshes.EachChunk(selectLevels);
+		}
+		else
+		{
+			meshes.Where<Changed<Components::Transform>>(GetLastRunTick()).EachChunk(selectLevels);
+			meshes.Where<Changed<Components::Mesh>>(GetLastRunTick()).EachChunk(selectLevels);
+		}
+		m_CameraPosition = cameraPosition;
+		m_ProjectionScale = projectionScale;
+
+		// Only the switching meshes are written, so the rest of the chunks keep their change version
+		m_HasPendingLevels = false;
+		for (const LevelSwitch& levelSwitch : m_Switches)
+		{
+			Components::Mesh* mesh = entityManager->GetComponent<Components::Mesh>(levelSwitch.EntityId);
+			if (mesh->GetLODLevel() != levelSwitch.Level && !mesh->SetLODLevel(levelSwitch.Level))
+				m_HasPendingLevels = true;
+		}
+	}
+
+	uint32_t LODSystem::SelectLevel(const Components::MeshLODChain& lodChain, const uint32_t currentLevel, const float screenSize)
+	{
+		const uint32_t levelCount = static_cast<uint32_t>(lodChain.Levels.size());
+		uint32_t level = std::min(currentLevel, levelCount - 1);
+
+		// Move to more detailed levels while clearly above their threshold
+		while (level > 0 && screenSize >= lodChain.Levels[level - 1].ScreenSize * (1.0f + Hysteresis))
+			level--;
+		// Move to less detailed levels while clearly below the current threshold
+		while (level + 1 < levelCount && screenSize < lodChain.Levels[level].ScreenSize * (1.0f - Hysteresis))
+			level++;
+
+		return level;
+	}
+
+}
\ No newline at end of file
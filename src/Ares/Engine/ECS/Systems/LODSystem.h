@@ -0,0 +1,49 @@
+#pragma once
+#include <glm/vec3.hpp>
+
+#include "Engine/ECS/Core/System.h"
+
+namespace Ares::ECS {
+
+	namespace Components { struct MeshLODChain; }
+
+	namespace Systems {
+
+		// Picks the level of detail of every Mesh with a LOD chain from the size of its bounding
+		// sphere projected by the active camera.
+		//
+		// Levels only change once the size is past the threshold by a margin (Hysteresis), so
+		// instances sitting on a threshold don't flip between levels every frame. While the camera
+		// stays put only entities with changed transforms or meshes are looked at again.
+		class LODSystem : public System
+		{
+		public:
+			// Fraction of a threshold the projected size has to pass it by before switching
+			static constexpr float Hysteresis = 0.1f;
+
+		public:
+			LODSystem();
+
+			void OnUpdate(const Scene& scene, const Timestep& timestep) override;
+
+			// Level of a chain to use for a projected size, starting from the current level
+			static uint32_t SelectLevel(const Components::MeshLODChain& lodChain, const uint32_t currentLevel, const float screenSize);
+
+		private:
+			struct LevelSwitch
+			{
+				uint32_t EntityId;
+				uint32_t Level;
+			};
+
+		private:
+			std::vector<LevelSwitch> m_Switches;
+			glm::vec3 m_CameraPosition = glm::vec3(0.0f);
+			float m_ProjectionScale = 0.0f;
+			// A level switch waits for its asset to load, keep checking until it's done
+			bool m_HasPendingLevels = false;
+		};
+
+	}
+
+}
\ No newline at end of file
@@ -12,39 +12,50 @@ namespace Ares::ECS::Systems {
 	LightSystem::LightSystem()
 		: m_Buffer()
 	{
+		Reads<Components::Transform, Components::Light>();
 	}
 
 	void LightSystem::OnUpdate(const Scene& scene, const Timestep& timestep)
 	{
+		EntityManager* entityManager = scene.GetEntityManager();
+		View<const Components::Transform, const Components::Light> lights = entityManager->Query<const Components::Transform, const Components::Light>();
+
+		// Only rewrite the buffer if a light was added, removed or changed
+		const size_t lightCount = lights.Size();
+		if (lightCount == m_LightCount &&
+			lights.Where<Changed<Components::Transform>>(GetLastRunTick()).Size() == 0 &&
+			lights.Where<Changed<Components::Light>>(GetLastRunTick()).Size() == 0)
+		{
+			return;
+		}
+
 		std::unique_lock lock(m_Mutex);
+		m_LightCount = lightCount;
+		m_BufferVersion++;
 		m_Buffer.Count = 0;
-		EntityManager* entityManager = scene.GetEntityManager();
 
 		// Query entities with Transform and Light components
-		for (auto& entry : entityManager->GetEntityComponents())
-		{
-			const uint32_t entityId = entry.first;
-			Components::Transform* transform = entityManager->GetComponent<Components::Transform>(entityId);
-			Components::Light* light = entityManager->GetComponent<Components::Light>(entityId);
-			if (transform != nullptr && light != nullptr)
-			{
-				// Entity has transform and light component
+		lights.Each(
+			[this](const uint32_t entityId, const Components::Transform& transform, const Components::Light& light) {
+				if (m_Buffer.Count >= static_cast<int32_t>(std::size(m_Buffer.Lights)))
+					return;
+
 				const uint32_t lightIndex = m_Buffer.Count++;
 				LightBuffer::LightBufferElement& bufferElement = m_Buffer.Lights[lightIndex];
 
 				float lightType;
-				switch (light->GetType())
+				switch (light.GetType())
 				{
 				case Components::Light::Directional: lightType = 0.0f; break;
 				case Components::Light::Point: lightType = 1.0f; break;
 				default: lightType = 1.0f;
 				}
 
-				bufferElement.Position = glm::vec4(transform->GetPosition(), lightType);
-				bufferElement.Color = light->GetColor();
-				bufferElement.Properties = light->GetProperties();
+				bufferElement.Position = glm::vec4(transform.GetPosition(), lightType);
+				bufferElement.Color = light.GetColor();
+				bufferElement.Properties = light.GetProperties();
 			}
-		}
+		);
 	}
 
 	RawData LightSystem::GetLightBuffer() const
@@ -53,4 +64,10 @@ namespace Ares::ECS::Systems {
 		return RawData(&m_Buffer, sizeof(m_Buffer));
 	}
 
+	uint32_t LightSystem::GetBufferVersion() const
+	{
+		std::unique_lock lock(m_Mutex);
+		return m_BufferVersion;
+	}
+
 }
\ No newline at end of file
@@ -18,6 +18,8 @@ namespace Ares {
 			void OnUpdate(const Scene& scene, const Timestep& timestep) override;
 
 			RawData GetLightBuffer() const;
+			// Incremented every time the light buffer is rewritten
+			uint32_t GetBufferVersion() const;
 
 		private:
 			struct LightBuffer
@@ -35,6 +37,8 @@ namespace Ares {
 		private:
 			mutable std::shared_mutex m_Mutex;
 			LightBuffer m_Buffer;
+			uint32_t m_BufferVersion = 0;
+			size_t m_LightCount = 0;
 		};
 
 	}
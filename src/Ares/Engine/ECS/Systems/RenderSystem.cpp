@@ -1,8 +1,12 @@
 #include <arespch.h>
 #include "Engine/ECS/Systems/RenderSystem.h"
 
+#include <numeric>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "Engine/Core/Bounds.h"
+#include "Engine/Core/SIMD.h"
+#include "Engine/Core/ThreadPool.h"
 #include "Engine/Core/Timestep.h"
 #include "Engine/Core/Utility.h"
 #include "Engine/Data/RawData.h"
@@ -16,11 +20,125 @@
 #include "Engine/Renderer/VertexArray.h"
 #include "Engine/Renderer/RenderCommand.h"
 #include "Engine/Renderer/UniformBuffer.h"
+#include "Engine/Renderer/Assets/Shader.h"
 
 const uint32_t g_defaultWhiteTexture = 0xffffffff;
 
 namespace Ares::ECS::Systems {
 
+	namespace {
+
+		constexpr size_t CullLaneCount = 8;
+
+		constexpr UniformID ViewProjectionUniform("u_ViewProjection");
+		constexpr UniformID CameraPositionUniform("u_CameraPosition");
+
+		// SoA box centers & extents
+		struct BoxLanes
+		{
+			const float* Cx, * Cy, * Cz;
+			const float* Ex, * Ey, * Ez;
+		};
+
+		// A box is culled once it lies fully behind any plane, i.e. its center's signed distance
+		// plus its extents projected onto the plane normal is negative
+		inline void CullLane(const Frustum& frustum, const BoxLanes& boxes, const size_t i, uint8_t* visible)
+		{
+			for (const glm::vec4& plane : frustum.Planes)
+			{
+				const float distance = plane.x * boxes.Cx[i] + plane.y * boxes.Cy[i] + plane.z * boxes.Cz[i] + plane.w +
+					std::abs(plane.x) * boxes.Ex[i] + std::abs(plane.y) * boxes.Ey[i] + std::abs(plane.z) * boxes.Ez[i];
+				if (distance < 0.0f)
+				{
+					visible[i] = 0;
+					return;
+				}
+			}
+			visible[i] = 1;
+		}
+
+	#if defined(AR_SIMD_SSE)
+		inline void CullLanes4(const Frustum& frustum, const BoxLanes& boxes, const size_t offset, uint8_t* visible)
+		{
+			const __m128 cx = _mm_loadu_ps(boxes.Cx + offset), cy = _mm_loadu_ps(boxes.Cy + offset), cz = _mm_loadu_ps(boxes.Cz + offset);
+			const __m128 ex = _mm_loadu_ps(boxes.Ex + offset), ey = _mm_loadu_ps(boxes.Ey + offset), ez = _mm_loadu_ps(boxes.Ez + offset);
+			const __m128 zero = _mm_setzero_ps();
+
+			__m128 inside = _mm_cmpeq_ps(zero, zero);
+			for (const glm::vec4& plane : frustum.Planes)
+			{
+				const __m128 center = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), cx), _mm_mul_ps(_mm_set1_ps(plane.y), cy)),
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), cz), _mm_set1_ps(plane.w))
+				);
+				const __m128 radius = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::abs(plane.x)), ex), _mm_mul_ps(_mm_set1_ps(std::abs(plane.y)), ey)),
+					_mm_mul_ps(_mm_set1_ps(std::abs(plane.z)), ez)
+				);
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(center, radius), zero));
+			}
+
+			const int mask = _mm_movemask_ps(inside);
+			for (size_t i = 0; i < 4; i++)
+				visible[offset + i] = static_cast<uint8_t>((mask >> i) & 1);
+		}
+	#endif
+
+	#if defined(AR_SIMD_AVX)
+		inline void CullLanes8(const Frustum& frustum, const BoxLanes& boxes, const size_t offset, uint8_t* visible)
+		{
+			const __m256 cx = _mm256_loadu_ps(boxes.Cx + offset), cy = _mm256_loadu_ps(boxes.Cy + offset), cz = _mm256_loadu_ps(boxes.Cz + offset);
+			const __m256 ex = _mm256_loadu_ps(boxes.Ex + offset), ey = _mm256_loadu_ps(boxes.Ey + offset), ez = _mm256_loadu_ps(boxes.Ez + offset);
+			const __m256 zero = _mm256_setzero_ps();
+
+			__m256 inside = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+			for (const glm::vec4& plane : frustum.Planes)
+			{
+				const __m256 center = _mm256_add_ps(
+					_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), cx), _mm256_mul_ps(_mm256_set1_ps(plane.y), cy)),
+					_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.z), cz), _mm256_set1_ps(plane.w))
+				);
+				const __m256 radius = _mm256_add_ps(
+					_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(std::abs(plane.x)), ex), _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.y)), ey)),
+					_mm256_mul_ps(_mm256_set1_ps(std::abs(plane.z)), ez)
+				);
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(center, radius), zero, _CMP_GE_OQ));
+			}
+
+			const int mask = _mm256_movemask_ps(inside);
+			for (size_t i = 0; i < 8; i++)
+				visible[offset + i] = static_cast<uint8_t>((mask >> i) & 1);
+		}
+	#endif
+
+		// Culls whole sets of lanes [begin, end) with the widest kernel available
+		inline void CullBoxes(const Frustum& frustum, const BoxLanes& boxes, const size_t begin, const size_t end, uint8_t* visible)
+		{
+			for (size_t offset = begin; offset < end; offset += CullLaneCount)
+			{
+			#if defined(AR_SIMD_AVX)
+				CullLanes8(frustum, boxes, offset, visible);
+			#elif defined(AR_SIMD_SSE)
+				CullLanes4(frustum, boxes, offset, visible);
+				CullLanes4(frustum, boxes, offset + 4, visible);
+			#else
+				for (size_t i = offset; i < offset + CullLaneCount; i++)
+					CullLane(frustum, boxes, i, visible);
+			#endif
+			}
+		}
+
+	}
+
+	RenderSystem::RenderSystem(InstanceBufferFactory instanceBufferFactory)
+		: m_InstanceBufferFactory(std::move(instanceBufferFactory))
+	{
+		Reads<Components::Mesh, Components::Material, Components::Transform, Components::Occluder, Components::Camera>();
+
+		// Batches create graphics resources while updating
+		RunOnMainThread();
+	}
+
 	void RenderSystem::OnInit(const Scene& scene)
 	{
 
@@ -34,136 +152,298 @@ namespace Ares::ECS::Systems {
 	void RenderSystem::OnUpdate(const Scene& scene, const Timestep& timestep)
 	{
 		EntityManager* entityManager = scene.GetEntityManager();
+		View<const Components::Mesh, const Components::Material, const Components::Transform> renderables =
+			entityManager->Query<const Components::Mesh, const Components::Material, const Components::Transform>();
+		View<const Components::Occluder, const Components::Transform> occluders =
+			entityManager->Query<const Components::Occluder, const Components::Transform>();
+
+		// Without an active camera nothing gets culled
+		const Components::Camera* activeCamera = entityManager->GetComponent<const Components::Camera>(scene.GetSystem<Systems::CameraSystem>()->GetActiveCameraEntityId());
+		const glm::mat4 viewProjection = activeCamera != nullptr ? activeCamera->GetViewProjectionMatrix() : glm::mat4(1.0f);
+
+		// Batches keep their instance data until an entity is added, removed or changed, or the
+		// camera moved (or an asset that was still loading during the last rebuild may have finished)
+		const size_t entityCount = renderables.Size();
+		const size_t occluderCount = occluders.Size();
+		const uint32_t lastRunTick = GetLastRunTick();
+		if (!m_HasPendingAssets && entityCount == m_EntityCount && occluderCount == m_OccluderCount && viewProjection == m_CullViewProjection &&
+			renderables.Where<Changed<Components::Transform>>(lastRunTick).Size() == 0 &&
+			renderables.Where<Changed<Components::Material>>(lastRunTick).Size() == 0 &&
+			renderables.Where<Changed<Components::Mesh>>(lastRunTick).Size() == 0 &&
+			occluders.Where<Changed<Components::Occluder>>(lastRunTick).Size() == 0 &&
+			occluders.Where<Changed<Components::Transform>>(lastRunTick).Size() == 0)
+		{
+			return;
+		}
+		m_EntityCount = entityCount;
+		m_OccluderCount = occluderCount;
+		m_CullViewProjection = viewProjection;
+		m_HasPendingAssets = false;
+		m_CameraPosition = activeCamera != nullptr ? activeCamera->GetPosition() : glm::vec3(0.0f);
+		m_CameraFar = activeCamera != nullptr ? std::max(activeCamera->GetNearFarPlanes().y, 1e-4f) : 1.0f;
+		m_Rebuild++;
+
+		for (auto& [key, batch] : m_DynamicBatches)
+			batch.translucent = false;
 
-		for (const auto& entity : entityManager->GetEntityComponents())
+		m_Renderables.clear();
+		renderables.Each(
+			[this](const uint32_t entityId, const Components::Mesh& mesh, const Components::Material& material, const Components::Transform& transform) {
+				m_Renderables.push_back({ entityId, &mesh, &material, &transform });
+			}
+		);
+
+		// Occluders are rasterized before culling, culling slices only read the finished pyramid
+		const bool testOcclusion = activeCamera != nullptr && occluderCount > 0;
+		if (testOcclusion)
+		{
+			m_OcclusionBuffer.Begin(viewProjection);
+			occluders.Each(
+				[this](const uint32_t entityId, const Components::Occluder& occluder, const Components::Transform& transform) {
+					m_OcclusionBuffer.RasterizeOccluder(
+						transform.GetWorldMatrix(),
+						occluder.Vertices.data(), occluder.Vertices.size(),
+						occluder.Indices.data(), occluder.Indices.size()
+					);
+				}
+			);
+			m_OcclusionBuffer.BuildHierarchy();
+		}
+
+		if (activeCamera != nullptr)
+			CullRenderables(viewProjection, testOcclusion);
+		else
+			m_Visibility.assign(m_Renderables.size(), 1);
+
+		for (size_t i = 0; i < m_Renderables.size(); i++)
+		{
+			if (m_Visibility[i])
+				SubmitDynamic(m_Renderables[i].entityId, m_Renderables[i].mesh, m_Renderables[i].material, m_Renderables[i].transform);
+		}
+
+		// Instances that weren't submitted (removed, culled or moved to another batch) give up their
+		// slot to the last one. Going backwards, the moved slot has already been checked
+		for (auto& [key, batch] : m_DynamicBatches)
 		{
-			const uint32_t entityId = entity.first;
-			Components::Mesh* mesh = entityManager->GetComponent<Components::Mesh>(entityId);
-			Components::Material* material = entityManager->GetComponent<Components::Material>(entityId);
-			Components::Transform* transform = entityManager->GetComponent<Components::Transform>(entityId);
-			if (mesh != nullptr && material != nullptr && transform != nullptr)
+			for (uint32_t slot = batch.instanceCount; slot-- > 0;)
 			{
-				SubmitDynamic(mesh, material, transform);
+				if (batch.slotRebuilds[slot] == m_Rebuild)
+					continue;
+
+				const uint32_t last = batch.instanceCount - 1;
+				batch.entitySlots.Erase(batch.slotEntities[slot]);
+				if (slot != last)
+				{
+					batch.transforms[slot] = batch.transforms[last];
+					batch.properties[slot] = batch.properties[last];
+					batch.depths[slot] = batch.depths[last];
+					batch.slotEntities[slot] = batch.slotEntities[last];
+					batch.slotRebuilds[slot] = batch.slotRebuilds[last];
+					batch.entitySlots[batch.slotEntities[slot]] = slot;
+					batch.dirtySlots[slot] = 1;
+					batch.isDirty = true;
+				}
+
+				batch.transforms.pop_back();
+				batch.properties.pop_back();
+				batch.depths.pop_back();
+				batch.slotEntities.pop_back();
+				batch.slotRebuilds.pop_back();
+				batch.dirtySlots.pop_back();
+				batch.instanceCount = last;
 			}
 		}
+
+		BuildRenderQueue();
+	}
+
+	void RenderSystem::CullRenderables(const glm::mat4& viewProjection, const bool testOcclusion)
+	{
+		const Frustum frustum(viewProjection);
+		const size_t count = m_Renderables.size();
+		const size_t paddedCount = (count + CullLaneCount - 1) / CullLaneCount * CullLaneCount;
+
+		for (std::vector<float>* lane : { &m_CullBounds.centerX, &m_CullBounds.centerY, &m_CullBounds.centerZ, &m_CullBounds.extentX, &m_CullBounds.extentY, &m_CullBounds.extentZ })
+			lane->resize(paddedCount);
+		m_Visibility.resize(paddedCount);
+
+		const BoxLanes boxes = {
+			m_CullBounds.centerX.data(), m_CullBounds.centerY.data(), m_CullBounds.centerZ.data(),
+			m_CullBounds.extentX.data(), m_CullBounds.extentY.data(), m_CullBounds.extentZ.data()
+		};
+
+		// Slices start on a lane boundary, so each one gathers and tests its own lanes
+		auto cullSlice = [this, &frustum, &boxes, count, paddedCount, testOcclusion](const size_t begin, const size_t end) {
+			const size_t laneEnd = std::min((end + CullLaneCount - 1) / CullLaneCount * CullLaneCount, paddedCount);
+			for (size_t i = begin; i < laneEnd; i++)
+			{
+				// Padding lanes hold empty boxes at the origin
+				glm::vec3 center(0.0f), extents(0.0f);
+				if (i < count)
+				{
+					const AABB bounds = m_Renderables[i].mesh->GetBounds();
+					if (bounds.IsValid())
+					{
+						const AABB worldBounds = bounds.Transformed(m_Renderables[i].transform->GetWorldMatrix());
+						center = worldBounds.GetCenter();
+						extents = worldBounds.GetExtents();
+					}
+					else
+					{
+						// Meshes that are still loading have no bounds yet, they always pass for SubmitDynamic to deal with
+						extents = glm::vec3(std::numeric_limits<float>::max());
+					}
+				}
+
+				m_CullBounds.centerX[i] = center.x;
+				m_CullBounds.centerY[i] = center.y;
+				m_CullBounds.centerZ[i] = center.z;
+				m_CullBounds.extentX[i] = extents.x;
+				m_CullBounds.extentY[i] = extents.y;
+				m_CullBounds.extentZ[i] = extents.z;
+			}
+			CullBoxes(frustum, boxes, begin, laneEnd, m_Visibility.data());
+
+			if (!testOcclusion)
+				return;
+
+			// Frustum survivors are tested against the occluders (meshes still loading have no bounds to test)
+			for (size_t i = begin; i < std::min(laneEnd, count); i++)
+			{
+				if (!m_Visibility[i] || m_CullBounds.extentX[i] == std::numeric_limits<float>::max())
+					continue;
+
+				const glm::vec3 center(m_CullBounds.centerX[i], m_CullBounds.centerY[i], m_CullBounds.centerZ[i]);
+				const glm::vec3 extents(m_CullBounds.extentX[i], m_CullBounds.extentY[i], m_CullBounds.extentZ[i]);
+				m_Visibility[i] = m_OcclusionBuffer.IsVisible(AABB(center - extents, center + extents));
+			}
+		};
+
+		if (count >= CullParallelThreshold)
+			ThreadPool::ParallelFor(count, CullSliceSize, cullSlice);
+		else
+			cullSlice(0, count);
 	}
 
 	void RenderSystem::OnRender(const Scene& scene)
 	{
+		StreamLightBuffer(scene);
 		UpdateInstanceBuffers(scene);
 		RenderDynamic(scene);
 	}
 
+	void RenderSystem::StreamLightBuffer(const Scene& scene)
+	{
+		Systems::LightSystem* lights = scene.GetSystem<Systems::LightSystem>();
+		const uint32_t lightBufferVersion = lights->GetBufferVersion();
+		m_LightStreamAllocator.BeginFrame();
+
+		// The light block is streamed again when the LightSystem rewrote it, or once the frame that
+		// streamed it retired and its range can be recycled
+		const uint64_t frame = m_LightStreamAllocator.GetFrameIndex();
+		if (m_LightStream != nullptr && lightBufferVersion == m_LightBufferVersion && frame - m_LightStreamFrame < FramesInFlight)
+			return;
+
+		const RawData lightBuffer = lights->GetLightBuffer();
+		size_t offset = m_LightStreamAllocator.Allocate(lightBuffer.Size, UniformBuffer::UniformOffsetAlignment);
+		if (offset == FrameRingAllocator::InvalidOffset)
+		{
+			// One aligned block per frame in flight, a new buffer never aliases ranges the GPU may still read
+			const size_t blockSize = (lightBuffer.Size + UniformBuffer::UniformOffsetAlignment - 1) & ~(UniformBuffer::UniformOffsetAlignment - 1);
+			m_LightStream = UniformBuffer::Create(blockSize * FramesInFlight, 0, BufferUsage::Dynamic);
+			m_LightStreamAllocator.Reset(m_LightStream->GetSize());
+			offset = m_LightStreamAllocator.Allocate(lightBuffer.Size, UniformBuffer::UniformOffsetAlignment);
+		}
+
+		m_LightStream->SetSubData(lightBuffer, static_cast<uint32_t>(offset));
+		m_LightStream->BindRange(offset, lightBuffer.Size);
+		m_LightBufferVersion = lightBufferVersion;
+		m_LightStreamFrame = frame;
+	}
+
 	void RenderSystem::UpdateInstanceBuffers(const Scene& scene)
 	{
 		for (auto& [key, batch] : m_DynamicBatches)
 		{
-			if (batch.isDirty)
+			if (!batch.isDirty)
+				continue;
+
+			const size_t transformStride = sizeof(glm::mat4);
+			const size_t propertiesStride = Components::MaterialProperties::GetSize();
+			if (batch.transformBuffer == nullptr || batch.instanceCount > batch.bufferCapacity)
 			{
+				// Grow with some headroom, everything has to be uploaded again
+				batch.bufferCapacity = std::max(batch.instanceCount + batch.instanceCount / 2, MinInstanceCapacity);
+				std::fill(batch.dirtySlots.begin(), batch.dirtySlots.end(), 1);
+
 				if (batch.transformBuffer == nullptr)
 				{
-					batch.transformBufferSize = batch.transforms.size() * sizeof(glm::mat4);
-					batch.transformBuffer = VertexBuffer::Create(
-						{ batch.transforms.data(), batch.transformBufferSize },
-						BufferUsage::Dynamic
-					);
-
+					batch.transformBuffer = CreateInstanceBuffer(batch.bufferCapacity * transformStride);
 					BufferLayout transformLayout({ { VertexDataType::Transform, true } });
 					batch.transformBuffer->SetBufferLayout(transformLayout);
 					batch.vao->AddVertexBuffer(batch.transformBuffer.get());
-				}
-				else
-				{
-					if (batch.transforms.size() * sizeof(glm::mat4) > batch.transformBufferSize)
-					{
-						batch.transformBufferSize = batch.transforms.size() * sizeof(glm::mat4);
-						batch.transformBuffer->SetData({ batch.transforms.data(), batch.transformBufferSize });
-					}
-					else
-					{
-						batch.transformBuffer->SetSubData({ batch.transforms.data(), batch.transforms.size() * sizeof(glm::mat4) });
-					}
-				}
 
-				if (batch.propertiesBuffer == nullptr)
-				{
-					std::vector<uint8_t> propsBuffer(batch.properties.size() * 56);
-					size_t offset = 0;
-					for (Components::MaterialProperties& props : batch.properties)
-					{
-						std::memcpy(propsBuffer.data() + offset, props.GetBuffer(), props.GetSize());
-						offset += props.GetSize();
-					}
-
-					batch.propertiesBuffer = VertexBuffer::Create({ propsBuffer.data(), propsBuffer.size() }, BufferUsage::Dynamic);
-					BufferLayout propsLayout({
-						{ VertexDataType::ColorRGB, true },
-						{ VertexDataType::Alpha, true, true },
-						{ VertexDataType::Roughness, true, true },
-						{ VertexDataType::Metallic, true, true },
-						{ VertexDataType::Reflectivity, true, true },
-						{ VertexDataType::EmissiveColor, true },
-						{ VertexDataType::EmissiveIntensity, true, true }
-					});
-					batch.propertiesBuffer->SetBufferLayout(propsLayout);
+					batch.propertiesBuffer = CreateInstanceBuffer(batch.bufferCapacity * propertiesStride);
+					batch.propertiesBuffer->SetBufferLayout(Components::MaterialProperties::GetBufferLayout());
 					batch.vao->AddVertexBuffer(batch.propertiesBuffer.get());
 				}
 				else
 				{
-					std::vector<uint8_t> propsBuffer(batch.properties.size() * 56);
-					size_t offset = 0;
-					for (Components::MaterialProperties& props : batch.properties)
-					{
-						std::memcpy(propsBuffer.data() + offset, props.GetBuffer(), props.GetSize());
-						offset += props.GetSize();
-					}
-					if (propsBuffer.size() > batch.propertiesBuffer->GetSize())
-					{
-						batch.propertiesBuffer->SetData({ propsBuffer.data(), propsBuffer.size() });
-					}
-					else
-					{
-						batch.propertiesBuffer->SetSubData({ propsBuffer.data(), propsBuffer.size() });
-					}
+					batch.transformBuffer->SetData({ nullptr, batch.bufferCapacity * transformStride });
+					batch.propertiesBuffer->SetData({ nullptr, batch.bufferCapacity * propertiesStride });
 				}
+			}
 
-				if (batch.uniformBuffer == nullptr)
+			// Upload runs of dirty slots, merging runs separated by only a few clean ones
+			uint32_t slot = 0;
+			while (slot < batch.instanceCount)
+			{
+				if (!batch.dirtySlots[slot])
 				{
-					Systems::LightSystem* lights = scene.GetSystem<Systems::LightSystem>();
-					batch.uniformBuffer = UniformBuffer::Create(lights->GetLightBuffer(), 0, BufferUsage::Dynamic);
+					slot++;
+					continue;
 				}
-				else
+
+				const uint32_t begin = slot;
+				uint32_t end = slot + 1;
+				for (uint32_t next = end; next < batch.instanceCount && next - end < UploadMergeGap; next++)
 				{
-					Systems::LightSystem* lights = scene.GetSystem<Systems::LightSystem>();
-					RawData lightBuffer = lights->GetLightBuffer();
-					if (lightBuffer.Size > batch.uniformBuffer->GetSize())
-					{
-						batch.uniformBuffer->SetData(lightBuffer);
-					}
-					else
-					{
-						batch.uniformBuffer->SetSubData(lightBuffer);
-					}
+					if (batch.dirtySlots[next])
+						end = next + 1;
 				}
 
-				batch.isDirty = false;
+				const size_t count = end - begin;
+				batch.transformBuffer->SetSubData(
+					{ &batch.transforms[begin], count * transformStride },
+					static_cast<uint32_t>(begin * transformStride)
+				);
+				batch.propertiesBuffer->SetSubData(
+					{ &batch.properties[begin], count * propertiesStride },
+					static_cast<uint32_t>(begin * propertiesStride)
+				);
+
+				std::fill(batch.dirtySlots.begin() + begin, batch.dirtySlots.begin() + end, 0);
+				slot = end;
 			}
+
+			batch.isDirty = false;
 		}
 	}
 
 	void RenderSystem::SubmitDynamic(
-		Components::Mesh* mesh,
-		Components::Material* material,
-		Components::Transform* transform
+		const uint32_t entityId,
+		const Components::Mesh* mesh,
+		const Components::Material* material,
+		const Components::Transform* transform
 	)
 	{
+		if (!mesh->IsLoaded() || !material->IsLoaded())
+			m_HasPendingAssets = true;
+
 		if (mesh->IsLoaded() && material->IsLoaded())
 		{
 			MeshBatch& batch = m_DynamicBatches[GenerateBatchKey(mesh, material)];
 
-			if (!batch.isDirty)
-				batch.instanceCount = 0;
-
 			if (batch.vao == nullptr)
 			{
 				// New batch
@@ -172,28 +452,133 @@ namespace Ares::ECS::Systems {
 				batch.vao->AddVertexBuffer(mesh->GetTextureBuffer());
 				batch.vao->AddVertexBuffer(mesh->GetNormalBuffer());
 				batch.vao->SetIndexBuffer(mesh->GetIndexBuffer());
+
+				batch.shaderAssetId = material->GetShaderAsset()->GetAssetId();
+				batch.meshKey = mesh->GetBatchKey();
+				batch.materialKey = material->GetBatchKey();
 			}
-			if (batch.material == nullptr)
+			// Once per rebuild, instances of a batch only differ in their material properties
+			if (batch.materialRebuild != m_Rebuild)
 			{
-				batch.material = material;
+				batch.material = *material;
+				batch.materialRebuild = m_Rebuild;
 			}
-			batch.transforms.push_back(transform->GetTransformationMatrix());
-			batch.properties.push_back(material->GetProperties());
 
-			batch.instanceCount++;
-			batch.isDirty = true;
+			const Components::MaterialProperties& properties = material->GetProperties();
+			const glm::mat4 worldMatrix = transform->GetWorldMatrix();
+			batch.translucent = batch.translucent || properties.Basic.Alpha < 1.0f;
+
+			auto [slotEntry, newSlot] = batch.entitySlots.TryEmplace(entityId, batch.instanceCount);
+			const uint32_t slot = slotEntry->second;
+			if (newSlot)
+			{
+				batch.transforms.push_back(worldMatrix);
+				batch.properties.push_back(properties);
+				batch.depths.push_back(0.0f);
+				batch.slotEntities.push_back(entityId);
+				batch.slotRebuilds.push_back(0);
+				batch.dirtySlots.push_back(1);
+				batch.instanceCount++;
+				batch.isDirty = true;
+			}
+			else
+			{
+				// Only instances whose data changed are uploaded again
+				if (std::memcmp(&batch.transforms[slot], &worldMatrix, sizeof(glm::mat4)) != 0 ||
+					std::memcmp(&batch.properties[slot], &properties, sizeof(properties)) != 0)
+				{
+					batch.transforms[slot] = worldMatrix;
+					batch.properties[slot] = properties;
+					batch.dirtySlots[slot] = 1;
+					batch.isDirty = true;
+				}
+			}
+			batch.depths[slot] = glm::length(glm::vec3(worldMatrix[3]) - m_CameraPosition);
+			batch.slotRebuilds[slot] = m_Rebuild;
 		}
 		else if (mesh != nullptr && material != nullptr && mesh->IsValid() && material->IsValid())
 		{
 			const size_t batchKey = GenerateBatchKey(mesh, material);
-			m_DynamicBatches.erase(batchKey);
+			m_DynamicBatches.Erase(batchKey);
+		}
+	}
+
+	void RenderSystem::BuildRenderQueue()
+	{
+		m_RenderQueue.Clear();
+		m_QueuedBatches.clear();
+
+		// Dense ids, so the key bits of different shaders, materials & meshes never collide
+		FlatMap<uint32_t, uint32_t> shaderIds;
+		FlatMap<size_t, uint32_t> materialIds;
+		FlatMap<size_t, uint32_t> meshIds;
+
+		for (auto& [key, batch] : m_DynamicBatches)
+		{
+			if (batch.instanceCount == 0)
+				continue;
+
+			float depth = 0.0f;
+			if (batch.translucent)
+			{
+				// Instances blend over each other too, so they're also sorted back to front
+				SortScratch& scratch = m_SortScratch;
+				scratch.order.resize(batch.instanceCount);
+				std::iota(scratch.order.begin(), scratch.order.end(), 0);
+				std::sort(scratch.order.begin(), scratch.order.end(), [&batch](const uint32_t a, const uint32_t b) { return batch.depths[a] > batch.depths[b]; });
+
+				scratch.transforms.resize(batch.instanceCount);
+				scratch.properties.resize(batch.instanceCount);
+				scratch.depths.resize(batch.instanceCount);
+				scratch.slotEntities.resize(batch.instanceCount);
+				scratch.slotRebuilds.resize(batch.instanceCount);
+				for (uint32_t slot = 0; slot < batch.instanceCount; slot++)
+				{
+					const uint32_t from = scratch.order[slot];
+					scratch.transforms[slot] = batch.transforms[from];
+					scratch.properties[slot] = batch.properties[from];
+					scratch.depths[slot] = batch.depths[from];
+					scratch.slotEntities[slot] = batch.slotEntities[from];
+					scratch.slotRebuilds[slot] = batch.slotRebuilds[from];
+					if (from != slot)
+					{
+						batch.entitySlots[scratch.slotEntities[slot]] = slot;
+						batch.dirtySlots[slot] = 1;
+						batch.isDirty = true;
+					}
+				}
+				// The batch's previous arrays become the scratch space of the next translucent batch
+				batch.transforms.swap(scratch.transforms);
+				batch.properties.swap(scratch.properties);
+				batch.depths.swap(scratch.depths);
+				batch.slotEntities.swap(scratch.slotEntities);
+				batch.slotRebuilds.swap(scratch.slotRebuilds);
+
+				depth = batch.depths.front();
+			}
+			else
+			{
+				depth = *std::min_element(batch.depths.begin(), batch.depths.end());
+			}
+
+			const uint32_t shaderId = shaderIds.TryEmplace(batch.shaderAssetId, static_cast<uint32_t>(shaderIds.Size())).first->second;
+			const uint32_t materialId = materialIds.TryEmplace(batch.materialKey, static_cast<uint32_t>(materialIds.Size())).first->second;
+			const uint32_t meshId = meshIds.TryEmplace(batch.meshKey, static_cast<uint32_t>(meshIds.Size())).first->second;
+
+			m_RenderQueue.Push(
+				RenderQueue::MakeKey(RenderQueue::Pass::Forward, batch.translucent, shaderId, materialId, meshId, depth / m_CameraFar),
+				static_cast<uint32_t>(m_QueuedBatches.size())
+			);
+			m_QueuedBatches.push_back(&batch);
 		}
+
+		m_RenderQueue.Sort();
 	}
 
 	void RenderSystem::RenderDynamic(const Scene& scene)
 	{
 		Systems::CameraSystem* cameraSystem = scene.GetSystem<Systems::CameraSystem>();
-		Components::Camera* activeCamera = scene.GetEntityManager()->GetComponent<Components::Camera>(cameraSystem->GetActiveCameraEntityId());
+		const Components::Camera* activeCamera = scene.GetEntityManager()->GetComponent<const Components::Camera>(cameraSystem->GetActiveCameraEntityId());
 		const glm::vec2 viewportSize = cameraSystem->GetViewportSize();
 
 		RenderCommand::SetClearColor({ 0.0f, 0.0f, 0.0f, 1.0f });
@@ -203,28 +588,58 @@ namespace Ares::ECS::Systems {
 			static_cast<uint32_t>(viewportSize.x), static_cast<uint32_t>(viewportSize.y)
 		);
 
-		for (auto& [key, batch] : m_DynamicBatches)
+		// Shaders & textures are only rebound when their key bits change. Camera uniforms are program
+		// state, so they're only uploaded when the shader changes
+		bool hasBound = false;
+		uint32_t boundShaderId = 0;
+		uint32_t boundMaterialId = 0;
+		for (const RenderQueue::Entry& entry : m_RenderQueue.GetEntries())
 		{
-			if (activeCamera != nullptr)
+			MeshBatch& batch = *m_QueuedBatches[entry.Index];
+			const uint32_t shaderId = RenderQueue::GetShaderId(entry.Key);
+			const uint32_t materialId = RenderQueue::GetMaterialId(entry.Key);
+			const bool shaderChanged = !hasBound || shaderId != boundShaderId;
+			const bool materialChanged = shaderChanged || materialId != boundMaterialId;
+
+			if (materialChanged)
 			{
-				batch.material->SetUniformProperty("u_ViewProjection", activeCamera->GetViewProjectionMatrix());
-				batch.material->SetUniformProperty("u_CameraPosition", activeCamera->GetPosition());
+				batch.material.Bind(shaderChanged, materialChanged);
+				if (shaderChanged && activeCamera != nullptr)
+				{
+					const Ref<Asset>& shaderAsset = batch.material.GetShaderAsset();
+					ShaderProgram* shader = shaderAsset->GetState() == AssetState::Loaded ? shaderAsset->GetAsset<ShaderProgram>() : nullptr;
+					if (shader != nullptr)
+					{
+						shader->SetMat4(ViewProjectionUniform, activeCamera->GetViewProjectionMatrix());
+						shader->SetFloat3(CameraPositionUniform, activeCamera->GetPosition());
+					}
+				}
+				hasBound = true;
+				boundShaderId = shaderId;
+				boundMaterialId = materialId;
 			}
 
-			batch.material->Bind();
-			
 			RenderCommand::DrawInstanced(batch.vao, batch.instanceCount);
-			batch.vao->Unbind();
-			batch.transforms.clear();
-			batch.properties.clear();
 		}
+
+		if (!m_QueuedBatches.empty())
+			m_QueuedBatches.front()->vao->Unbind();
+	}
+
+	Scope<VertexBuffer> RenderSystem::CreateInstanceBuffer(const size_t size) const
+	{
+		if (m_InstanceBufferFactory)
+			return m_InstanceBufferFactory(size);
+
+		return VertexBuffer::Create(size, BufferUsage::Dynamic);
 	}
 
-	const size_t RenderSystem::GenerateBatchKey(Components::Mesh* mesh, Components::Material* material)
+	const size_t RenderSystem::GenerateBatchKey(const Components::Mesh* mesh, const Components::Material* material)
 	{
+		// Both keys are cached by the components, so no assets or texture names get hashed here
 		size_t result = 66688666;
-		CombineHash<Components::Mesh>(result, *mesh);
-		CombineHash<Components::Material>(result, *material);
+		CombineHash<size_t>(result, mesh->GetBatchKey());
+		CombineHash<size_t>(result, material->GetBatchKey());
 		return result;
 	}
 
@@ -1,7 +1,12 @@
 #pragma once
 #include <glm/mat4x4.hpp>
 
+#include "Engine/Core/FlatMap.h"
+#include "Engine/ECS/Components/Material.h"
 #include "Engine/ECS/Core/System.h"
+#include "Engine/Renderer/FrameRingAllocator.h"
+#include "Engine/Renderer/OcclusionBuffer.h"
+#include "Engine/Renderer/RenderQueue.h"
 
 namespace Ares {
 
@@ -14,17 +19,49 @@ namespace Ares {
 		namespace Components {
 
 			class Mesh;
-			class Material;
-			class MaterialProperties;
 			class Transform;
 
 		}
 		
 		namespace Systems {
 
+			// Batches every renderable entity by mesh & material into instanced draws.
+			//
+			// Before batching, entities are culled against the active camera's frustum: their world
+			// space bounds are gathered into SIMD lanes (8 boxes per test with AVX, 4 with SSE) and
+			// large scenes are split across the thread pool. When the scene has Occluder entities, their
+			// geometry is rasterized into a software depth buffer first and frustum survivors are also
+			// tested against its hierarchical-Z pyramid, so only visible instances get uploaded.
+			//
+			// Batches are drawn through a RenderQueue sorted by state and depth: opaque batches grouped
+			// by shader & material (front to back), then translucent ones back to front, so shaders and
+			// textures are only rebound when the sorted keys change.
+			//
+			// Every instance keeps a slot in its batch for as long as it stays visible, and only the
+			// slots that changed are uploaded again. The light block is streamed through a frame ring
+			// shared by every batch.
 			class RenderSystem : public System
 			{
 			public:
+				// Scenes with at least this many renderables are culled across threads
+				static constexpr size_t CullParallelThreshold = 4096;
+				static constexpr size_t CullSliceSize = 1024;
+				// Resolution of the occlusion depth buffer
+				static constexpr uint32_t OcclusionWidth = 256;
+				static constexpr uint32_t OcclusionHeight = 128;
+				// Dirty slots closer than this are uploaded in a single range
+				static constexpr uint32_t UploadMergeGap = 8;
+				static constexpr uint32_t MinInstanceCapacity = 16;
+				// Frames the GPU may lag behind before streamed ranges are recycled
+				static constexpr uint32_t FramesInFlight = 3;
+
+				// Creates the instance buffers of the batches (size in bytes). Lets tools and tests swap in
+				// buffers like CountingVertexBuffer to measure uploads, VertexBuffer::Create by default
+				using InstanceBufferFactory = std::function<Scope<VertexBuffer>(const size_t size)>;
+
+			public:
+				RenderSystem(InstanceBufferFactory instanceBufferFactory = nullptr);
+
 				void OnInit(const Scene& scene);
 				void OnShutdown(const Scene& scene);
 
@@ -32,16 +69,23 @@ namespace Ares {
 				void OnRender(const Scene& scene);
 
 			private:
+				// Fills m_Visibility for every collected renderable
+				void CullRenderables(const glm::mat4& viewProjection, const bool testOcclusion);
+				void StreamLightBuffer(const Scene& scene);
 				void UpdateInstanceBuffers(const Scene& scene);
 				void SubmitDynamic(
-					Components::Mesh* mesh,
-					Components::Material* material,
-					Components::Transform* transform
+					const uint32_t entityId,
+					const Components::Mesh* mesh,
+					const Components::Material* material,
+					const Components::Transform* transform
 				);
+				// Sorts the filled batches into m_RenderQueue
+				void BuildRenderQueue();
 				void RenderDynamic(const Scene& scene);
+				Scope<VertexBuffer> CreateInstanceBuffer(const size_t size) const;
 				const size_t GenerateBatchKey(
-					Components::Mesh* mesh,
-					Components::Material* material
+					const Components::Mesh* mesh,
+					const Components::Material* material
 				);
 
 			private:
@@ -50,17 +94,81 @@ namespace Ares {
 					Ref<VertexArray> vao = nullptr;
 					Scope<VertexBuffer> transformBuffer = nullptr;
 					Scope<VertexBuffer> propertiesBuffer = nullptr;
-					Scope<UniformBuffer> uniformBuffer = nullptr;
-					Components::Material* material = nullptr;
+					// Copy of the material, so drawing never reads component storage that structural
+					// changes or other systems may have moved since the update
+					Components::Material material;
+					// Rebuild in which the material was last copied
+					uint32_t materialRebuild = 0;
+					// Instance slots, [0, instanceCount) are drawn
 					std::vector<glm::mat4> transforms;
 					std::vector<Components::MaterialProperties> properties;
+					// Distance of each instance to the camera
+					std::vector<float> depths;
+					std::vector<uint32_t> slotEntities;
+					// Rebuild in which each slot was last submitted
+					std::vector<uint32_t> slotRebuilds;
+					std::vector<uint8_t> dirtySlots;
+					FlatMap<uint32_t, uint32_t> entitySlots;
 					uint32_t instanceCount = 0;
 					bool isDirty = false;
-					size_t transformBufferSize = 0;
+					// Slots allocated in the instance buffers
+					uint32_t bufferCapacity = 0;
+					// Render queue sorting
+					uint32_t shaderAssetId = 0;
+					size_t meshKey = 0;
+					size_t materialKey = 0;
+					bool translucent = false;
+				};
+
+				struct Renderable
+				{
+					uint32_t entityId = 0;
+					const Components::Mesh* mesh = nullptr;
+					const Components::Material* material = nullptr;
+					const Components::Transform* transform = nullptr;
+				};
+
+				// Reused while sorting translucent instances back to front, so rebuilds don't allocate
+				struct SortScratch
+				{
+					std::vector<uint32_t> order;
+					std::vector<glm::mat4> transforms;
+					std::vector<Components::MaterialProperties> properties;
+					std::vector<float> depths;
+					std::vector<uint32_t> slotEntities;
+					std::vector<uint32_t> slotRebuilds;
+				};
+
+				// World space bounds of the renderables in SoA form, padded to whole SIMD lanes
+				struct CullBounds
+				{
+					std::vector<float> centerX, centerY, centerZ;
+					std::vector<float> extentX, extentY, extentZ;
 				};
 
 			private:
-				std::unordered_map<size_t, MeshBatch> m_DynamicBatches;
+				// Keyed by the cached mesh & material batch keys, entries move when the map changes
+				FlatMap<size_t, MeshBatch> m_DynamicBatches;
+				RenderQueue m_RenderQueue;
+				// Batches referenced by the render queue entries, valid until the batches change again
+				std::vector<MeshBatch*> m_QueuedBatches;
+				SortScratch m_SortScratch;
+				glm::vec3 m_CameraPosition = glm::vec3(0.0f);
+				float m_CameraFar = 1.0f;
+				std::vector<Renderable> m_Renderables;
+				CullBounds m_CullBounds;
+				std::vector<uint8_t> m_Visibility;
+				glm::mat4 m_CullViewProjection = glm::mat4(1.0f);
+				OcclusionBuffer m_OcclusionBuffer = OcclusionBuffer(OcclusionWidth, OcclusionHeight);
+				size_t m_OccluderCount = 0;
+				size_t m_EntityCount = 0;
+				uint32_t m_Rebuild = 0;
+				Scope<UniformBuffer> m_LightStream = nullptr;
+				FrameRingAllocator m_LightStreamAllocator = FrameRingAllocator(0, FramesInFlight);
+				uint32_t m_LightBufferVersion = 0;
+				uint64_t m_LightStreamFrame = 0;
+				bool m_HasPendingAssets = false;
+				InstanceBufferFactory m_InstanceBufferFactory;
 			};
 
 		}
@@ -0,0 +1,381 @@
+#include <arespch.h>
+#include "Engine/ECS/Systems/SpatialIndexSystem.h"
+
+#include "Engine/Core/Timestep.h"
+#include "Engine/ECS/Components/Mesh.h"
+#include "Engine/ECS/Components/Transform.h"
+#include "Engine/ECS/Core/EntityManager.h"
+#include "Engine/ECS/Core/Scene.h"
+
+namespace Ares::ECS::Systems {
+
+	SpatialIndexSystem::SpatialIndexSystem()
+	{
+		Reads<Components::Transform, Components::Mesh>();
+	}
+
+	void SpatialIndexSystem::OnUpdate(const Scene& scene, const Timestep& timestep)
+	{
+		EntityManager* entityManager = scene.GetEntityManager();
+		std::unique_lock lock(m_Mutex);
+
+		// Only chunks with moved transforms or changed meshes can hold entities whose bounds changed
+		auto updateChunk = [this](const size_t count, const uint32_t* entities, const Components::Transform* transforms, const Components::Mesh* meshes) {
+			for (size_t i = 0; i < count; i++)
+			{
+				const AABB bounds = meshes[i].GetBounds();
+				if (!bounds.IsValid())
+				{
+					RemoveEntity(entities[i]);
+					m_PendingEntities.insert(entities[i]);
+					continue;
+				}
+				UpdateEntity(entities[i], bounds.Transformed(transforms[i].GetWorldMatrix()));
+			}
+		};
+		entityManager->Query<const Components::Transform, const Components::Mesh>().Where<Changed<Components::Transform>>(GetLastRunTick()).EachChunk(updateChunk);
+		entityManager->Query<const Components::Transform, const Components::Mesh>().Where<Changed<Components::Mesh>>(GetLastRunTick()).EachChunk(updateChunk);
+
+		// Mesh loading doesn't change the component, so keep checking entities waiting for theirs
+		for (auto it = m_PendingEntities.begin(); it != m_PendingEntities.end();)
+		{
+			const uint32_t entityId = *it;
+			const Components::Mesh* mesh = entityManager->GetComponent<const Components::Mesh>(entityId);
+			const Components::Transform* transform = entityManager->GetComponent<const Components::Transform>(entityId);
+			if (mesh == nullptr || transform == nullptr)
+			{
+				it = m_PendingEntities.erase(it);
+				continue;
+			}
+
+			const AABB bounds = mesh->GetBounds();
+			if (!bounds.IsValid())
+			{
+				++it;
+				continue;
+			}
+			it = m_PendingEntities.erase(it);
+			UpdateEntity(entityId, bounds.Transformed(transform->GetWorldMatrix()));
+		}
+
+		// Every matching entity has been seen, so any extra tracked entity was destroyed or lost a component
+		const size_t matchCount = entityManager->Query<const Components::Transform, const Components::Mesh>().Size();
+		if (m_EntityLeaves.size() + m_PendingEntities.size() > matchCount)
+		{
+			std::vector<uint32_t> removed;
+			for (const auto& [entityId, leaf] : m_EntityLeaves)
+			{
+				if (entityManager->GetComponent<const Components::Mesh>(entityId) == nullptr || entityManager->GetComponent<const Components::Transform>(entityId) == nullptr)
+					removed.push_back(entityId);
+			}
+			for (const uint32_t entityId : removed)
+				RemoveEntity(entityId);
+		}
+
+		// Incremental inserts degrade the tree, rebuild once a good part of it has been reinserted
+		if (m_InsertCount >= std::max<size_t>(m_EntityLeaves.size() / 2, 64))
+			Rebuild();
+	}
+
+	void SpatialIndexSystem::QueryAABB(const AABB& bounds, std::vector<uint32_t>& entities) const
+	{
+		std::shared_lock lock(m_Mutex);
+		Traverse(
+			[&bounds](const AABB& box) { return bounds.Intersects(box); },
+			[&entities](const Node& leaf) { entities.push_back(leaf.EntityId); }
+		);
+	}
+
+	void SpatialIndexSystem::QuerySphere(const BoundingSphere& sphere, std::vector<uint32_t>& entities) const
+	{
+		std::shared_lock lock(m_Mutex);
+		Traverse(
+			[&sphere](const AABB& box) { return sphere.Intersects(box); },
+			[&entities](const Node& leaf) { entities.push_back(leaf.EntityId); }
+		);
+	}
+
+	void SpatialIndexSystem::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& entities) const
+	{
+		std::shared_lock lock(m_Mutex);
+		Traverse(
+			[&frustum](const AABB& box) { return frustum.Intersects(box); },
+			[&entities](const Node& leaf) { entities.push_back(leaf.EntityId); }
+		);
+	}
+
+	bool SpatialIndexSystem::Raycast(const Ray& ray, const float maxDistance, RaycastHit& hit) const
+	{
+		std::shared_lock lock(m_Mutex);
+		const glm::vec3 inverseDirection = ray.GetInverseDirection();
+		float closest = maxDistance;
+		bool result = false;
+
+		// Nodes further than the closest hit so far are skipped
+		Traverse(
+			[&](const AABB& box) {
+				float distance = 0.0f;
+				return ray.Intersects(box, inverseDirection, closest, distance);
+			},
+			[&](const Node& leaf) {
+				float distance = 0.0f;
+				ray.Intersects(leaf.EntityBounds, inverseDirection, closest, distance);
+				closest = distance;
+				hit = { leaf.EntityId, distance };
+				result = true;
+			}
+		);
+		return result;
+	}
+
+	AABB SpatialIndexSystem::GetBounds(const uint32_t entityId) const
+	{
+		std::shared_lock lock(m_Mutex);
+		auto it = m_EntityLeaves.find(entityId);
+		return it != m_EntityLeaves.end() ? m_Nodes[it->second].EntityBounds : AABB();
+	}
+
+	size_t SpatialIndexSystem::GetEntityCount() const
+	{
+		std::shared_lock lock(m_Mutex);
+		return m_EntityLeaves.size();
+	}
+
+	void SpatialIndexSystem::UpdateEntity(const uint32_t entityId, const AABB& bounds)
+	{
+		auto it = m_EntityLeaves.find(entityId);
+		if (it == m_EntityLeaves.end())
+		{
+			const int32_t leaf = AllocateNode();
+			m_Nodes[leaf].EntityId = entityId;
+			m_Nodes[leaf].EntityBounds = bounds;
+			m_Nodes[leaf].Bounds = bounds.Expanded(FatMargin);
+			InsertLeaf(leaf);
+			m_EntityLeaves[entityId] = leaf;
+			m_InsertCount++;
+			return;
+		}
+
+		// Small moves stay inside the fat box and leave the tree untouched
+		const int32_t leaf = it->second;
+		m_Nodes[leaf].EntityBounds = bounds;
+		if (m_Nodes[leaf].Bounds.Contains(bounds))
+			return;
+
+		RemoveLeaf(leaf);
+		m_Nodes[leaf].Bounds = bounds.Expanded(FatMargin);
+		InsertLeaf(leaf);
+		m_InsertCount++;
+	}
+
+	void SpatialIndexSystem::RemoveEntity(const uint32_t entityId)
+	{
+		auto it = m_EntityLeaves.find(entityId);
+		if (it == m_EntityLeaves.end())
+			return;
+
+		RemoveLeaf(it->second);
+		FreeNode(it->second);
+		m_EntityLeaves.erase(it);
+	}
+
+	void SpatialIndexSystem::InsertLeaf(const int32_t leaf)
+	{
+		if (m_Root == Null)
+		{
+			m_Root = leaf;
+			m_Nodes[leaf].Parent = Null;
+			return;
+		}
+
+		// Walk down to the cheapest sibling by surface area heuristic
+		const AABB leafBounds = m_Nodes[leaf].Bounds;
+		int32_t sibling = m_Root;
+		while (!m_Nodes[sibling].IsLeaf())
+		{
+			const Node& node = m_Nodes[sibling];
+			const float area = node.Bounds.GetSurfaceArea();
+			const float combinedArea = AABB::Merge(node.Bounds, leafBounds).GetSurfaceArea();
+
+			// Cost of a new parent for this node & the leaf, and the cost pushed down to the children
+			const float cost = 2.0f * combinedArea;
+			const float inheritedCost = 2.0f * (combinedArea - area);
+			auto childCost = [&](const int32_t child) {
+				const float childArea = AABB::Merge(m_Nodes[child].Bounds, leafBounds).GetSurfaceArea();
+				return m_Nodes[child].IsLeaf() ? childArea + inheritedCost : childArea - m_Nodes[child].Bounds.GetSurfaceArea() + inheritedCost;
+			};
+			const float leftCost = childCost(node.Left);
+			const float rightCost = childCost(node.Right);
+
+			if (cost < leftCost && cost < rightCost)
+				break;
+			sibling = leftCost < rightCost ? node.Left : node.Right;
+		}
+
+		const int32_t oldParent = m_Nodes[sibling].Parent;
+		const int32_t newParent = AllocateNode();
+		m_Nodes[newParent].Parent = oldParent;
+		m_Nodes[newParent].Left = sibling;
+		m_Nodes[newParent].Right = leaf;
+		m_Nodes[newParent].Bounds = AABB::Merge(m_Nodes[sibling].Bounds, leafBounds);
+		m_Nodes[sibling].Parent = newParent;
+		m_Nodes[leaf].Parent = newParent;
+
+		if (oldParent == Null)
+		{
+			m_Root = newParent;
+			return;
+		}
+
+		if (m_Nodes[oldParent].Left == sibling)
+			m_Nodes[oldParent].Left = newParent;
+		else
+			m_Nodes[oldParent].Right = newParent;
+		Refit(oldParent);
+	}
+
+	void SpatialIndexSystem::RemoveLeaf(const int32_t leaf)
+	{
+		if (leaf == m_Root)
+		{
+			m_Root = Null;
+			return;
+		}
+
+		// The leaf's sibling takes the place of their parent
+		const int32_t parent = m_Nodes[leaf].Parent;
+		const int32_t grandParent = m_Nodes[parent].Parent;
+		const int32_t sibling = m_Nodes[parent].Left == leaf ? m_Nodes[parent].Right : m_Nodes[parent].Left;
+
+		m_Nodes[sibling].Parent = grandParent;
+		if (grandParent == Null)
+		{
+			m_Root = sibling;
+		}
+		else
+		{
+			if (m_Nodes[grandParent].Left == parent)
+				m_Nodes[grandParent].Left = sibling;
+			else
+				m_Nodes[grandParent].Right = sibling;
+			Refit(grandParent);
+		}
+
+		FreeNode(parent);
+		m_Nodes[leaf].Parent = Null;
+	}
+
+	void SpatialIndexSystem::Refit(int32_t node)
+	{
+		while (node != Null)
+		{
+			Node& current = m_Nodes[node];
+			current.Bounds = AABB::Merge(m_Nodes[current.Left].Bounds, m_Nodes[current.Right].Bounds);
+			node = current.Parent;
+		}
+	}
+
+	void SpatialIndexSystem::Rebuild()
+	{
+		m_InsertCount = 0;
+		if (m_Root == Null)
+			return;
+
+		// Keep the leaves, drop every internal node
+		std::vector<int32_t> leaves;
+		leaves.reserve(m_EntityLeaves.size());
+		std::vector<int32_t> stack = { m_Root };
+		while (!stack.empty())
+		{
+			const int32_t node = stack.back();
+			stack.pop_back();
+			if (m_Nodes[node].IsLeaf())
+			{
+				leaves.push_back(node);
+				continue;
+			}
+
+			stack.push_back(m_Nodes[node].Left);
+			stack.push_back(m_Nodes[node].Right);
+			FreeNode(node);
+		}
+
+		m_Root = Build(leaves.data(), leaves.size());
+		m_Nodes[m_Root].Parent = Null;
+	}
+
+	int32_t SpatialIndexSystem::Build(int32_t* leaves, const size_t count)
+	{
+		if (count == 1)
+			return leaves[0];
+
+		AABB centroids;
+		for (size_t i = 0; i < count; i++)
+			centroids.Merge(m_Nodes[leaves[i]].Bounds.GetCenter());
+
+		const glm::vec3 size = centroids.Max - centroids.Min;
+		const int axis = size.x > size.y ? (size.x > size.z ? 0 : 2) : (size.y > size.z ? 1 : 2);
+		const size_t middle = count / 2;
+		std::nth_element(leaves, leaves + middle, leaves + count, [this, axis](const int32_t a, const int32_t b) {
+			return m_Nodes[a].Bounds.GetCenter()[axis] < m_Nodes[b].Bounds.GetCenter()[axis];
+		});
+
+		const int32_t left = Build(leaves, middle);
+		const int32_t right = Build(leaves + middle, count - middle);
+		const int32_t node = AllocateNode();
+		m_Nodes[node].Left = left;
+		m_Nodes[node].Right = right;
+		m_Nodes[node].Bounds = AABB::Merge(m_Nodes[left].Bounds, m_Nodes[right].Bounds);
+		m_Nodes[left].Parent = node;
+		m_Nodes[right].Parent = node;
+		return node;
+	}
+
+	int32_t SpatialIndexSystem::AllocateNode()
+	{
+		if (!m_FreeNodes.empty())
+		{
+			const int32_t node = m_FreeNodes.back();
+			m_FreeNodes.pop_back();
+			m_Nodes[node] = Node();
+			return node;
+		}
+
+		m_Nodes.emplace_back();
+		return static_cast<int32_t>(m_Nodes.size() - 1);
+	}
+
+	void SpatialIndexSystem::FreeNode(const int32_t node)
+	{
+		m_FreeNodes.push_back(node);
+	}
+
+	template <typename Test, typename Visit>
+	void SpatialIndexSystem::Traverse(Test&& test, Visit&& visit) const
+	{
+		if (m_Root == Null)
+			return;
+
+		std::vector<int32_t> stack;
+		stack.reserve(64);
+		stack.push_back(m_Root);
+		while (!stack.empty())
+		{
+			const Node& node = m_Nodes[stack.back()];
+			stack.pop_back();
+			if (!test(node.Bounds))
+				continue;
+
+			if (!node.IsLeaf())
+			{
+				stack.push_back(node.Left);
+				stack.push_back(node.Right);
+			}
+			else if (test(node.EntityBounds))
+			{
+				visit(node);
+			}
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+#include "Engine/Core/Bounds.h"
+#include "Engine/ECS/Core/System.h"
+
+namespace Ares::ECS::Systems {
+
+	// Dynamic AABB tree over the world space bounds of every entity with a Transform and a loaded Mesh.
+	//
+	// Leaves keep a fattened box, so entities that only move a little don't touch the tree. Entities
+	// leaving their fat box are removed and reinserted (refitting their ancestors on the way), and once
+	// enough leaves have been inserted since the last rebuild the tree is rebuilt top-down to restore
+	// its quality.
+	//
+	// The queries can be used from other systems (culling, picking, proximity checks) while the index
+	// isn't updating.
+	class SpatialIndexSystem : public System
+	{
+	public:
+		// Margin added around every leaf box
+		static constexpr float FatMargin = 0.1f;
+
+		struct RaycastHit
+		{
+			uint32_t EntityId = 0;
+			float Distance = 0.0f;
+		};
+
+	public:
+		SpatialIndexSystem();
+
+		void OnUpdate(const Scene& scene, const Timestep& timestep) override;
+
+		// Queries append the ids of every entity whose bounds pass the test
+		void QueryAABB(const AABB& bounds, std::vector<uint32_t>& entities) const;
+		void QuerySphere(const BoundingSphere& sphere, std::vector<uint32_t>& entities) const;
+		void QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& entities) const;
+		// Closest entity whose bounds the ray hits within maxDistance
+		bool Raycast(const Ray& ray, const float maxDistance, RaycastHit& hit) const;
+
+		// World space bounds of an indexed entity, invalid if the entity isn't indexed
+		AABB GetBounds(const uint32_t entityId) const;
+		size_t GetEntityCount() const;
+
+	private:
+		static constexpr int32_t Null = -1;
+
+		struct Node
+		{
+			// Fattened entity bounds for leaves, union of the children for internal nodes
+			AABB Bounds;
+			int32_t Parent = Null;
+			int32_t Left = Null;
+			int32_t Right = Null;
+
+			// Leaves only
+			AABB EntityBounds;
+			uint32_t EntityId = 0;
+
+			inline bool IsLeaf() const { return Left == Null; }
+		};
+
+		// Index maintenance (expects m_Mutex to be held)
+		void UpdateEntity(const uint32_t entityId, const AABB& bounds);
+		void RemoveEntity(const uint32_t entityId);
+		void InsertLeaf(const int32_t leaf);
+		void RemoveLeaf(const int32_t leaf);
+		void Refit(int32_t node);
+		void Rebuild();
+		// Top-down build, splitting at the median centroid along the widest axis
+		int32_t Build(int32_t* leaves, const size_t count);
+
+		int32_t AllocateNode();
+		void FreeNode(const int32_t node);
+
+		// Visits every leaf whose boxes (and those of its ancestors) pass the test
+		template <typename Test, typename Visit>
+		void Traverse(Test&& test, Visit&& visit) const;
+
+	private:
+		mutable std::shared_mutex m_Mutex;
+		std::vector<Node> m_Nodes;
+		std::vector<int32_t> m_FreeNodes;
+		int32_t m_Root = Null;
+
+		// Leaf of every indexed entity
+		std::unordered_map<uint32_t, int32_t> m_EntityLeaves;
+		// Entities whose mesh isn't loaded yet
+		std::unordered_set<uint32_t> m_PendingEntities;
+		// Leaves inserted since the last rebuild
+		size_t m_InsertCount = 0;
+	};
+
+}
\ No newline at end of file
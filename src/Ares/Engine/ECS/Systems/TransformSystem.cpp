@@ -0,0 +1,451 @@
+#include <arespch.h>
+#include "Engine/ECS/Systems/TransformSystem.h"
+
+#include "Engine/Core/SIMD.h"
+#include "Engine/Core/ThreadPool.h"
+#include "Engine/Core/Timestep.h"
+#include "Engine/ECS/Components/Hierarchy.h"
+#include "Engine/ECS/Components/Transform.h"
+#include "Engine/ECS/Core/EntityManager.h"
+#include "Engine/ECS/Core/Scene.h"
+
+namespace Ares::ECS::Systems {
+
+	namespace {
+
+		constexpr size_t LaneCount = 8;
+
+		// Positions, rotations and scales of up to LaneCount transforms in SoA form
+		struct TransformLanes
+		{
+			alignas(32) float Px[LaneCount], Py[LaneCount], Pz[LaneCount];
+			alignas(32) float Qx[LaneCount], Qy[LaneCount], Qz[LaneCount], Qw[LaneCount];
+			alignas(32) float Sx[LaneCount], Sy[LaneCount], Sz[LaneCount];
+		};
+
+		// Translation * Rotation * Scale written straight into a column-major matrix
+		inline void ComposeLane(const TransformLanes& lanes, const size_t i, glm::mat4& out)
+		{
+			const float x = lanes.Qx[i], y = lanes.Qy[i], z = lanes.Qz[i], w = lanes.Qw[i];
+			const float xx = x * x, yy = y * y, zz = z * z;
+			const float xy = x * y, xz = x * z, yz = y * z;
+			const float wx = w * x, wy = w * y, wz = w * z;
+
+			out[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * lanes.Sx[i], 2.0f * (xy + wz) * lanes.Sx[i], 2.0f * (xz - wy) * lanes.Sx[i], 0.0f);
+			out[1] = glm::vec4(2.0f * (xy - wz) * lanes.Sy[i], (1.0f - 2.0f * (xx + zz)) * lanes.Sy[i], 2.0f * (yz + wx) * lanes.Sy[i], 0.0f);
+			out[2] = glm::vec4(2.0f * (xz + wy) * lanes.Sz[i], 2.0f * (yz - wx) * lanes.Sz[i], (1.0f - 2.0f * (xx + yy)) * lanes.Sz[i], 0.0f);
+			out[3] = glm::vec4(lanes.Px[i], lanes.Py[i], lanes.Pz[i], 1.0f);
+		}
+
+	#if defined(AR_SIMD_SSE)
+		// Transposes four SoA rows into one matrix column for each of four matrices
+		inline void StoreColumn4(__m128 r0, __m128 r1, __m128 r2, __m128 r3, glm::mat4* const* out, const int column)
+		{
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			_mm_storeu_ps(&(*out[0])[column][0], r0);
+			_mm_storeu_ps(&(*out[1])[column][0], r1);
+			_mm_storeu_ps(&(*out[2])[column][0], r2);
+			_mm_storeu_ps(&(*out[3])[column][0], r3);
+		}
+
+		inline void ComposeLanes4(const TransformLanes& lanes, const size_t offset, glm::mat4* const* out)
+		{
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 two = _mm_set1_ps(2.0f);
+			const __m128 zero = _mm_setzero_ps();
+
+			const __m128 x = _mm_load_ps(lanes.Qx + offset), y = _mm_load_ps(lanes.Qy + offset);
+			const __m128 z = _mm_load_ps(lanes.Qz + offset), w = _mm_load_ps(lanes.Qw + offset);
+			const __m128 sx = _mm_load_ps(lanes.Sx + offset), sy = _mm_load_ps(lanes.Sy + offset), sz = _mm_load_ps(lanes.Sz + offset);
+
+			const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+			const __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+			const __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+			StoreColumn4(
+				_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+				_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+				_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx),
+				zero, out, 0
+			);
+			StoreColumn4(
+				_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+				_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+				_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy),
+				zero, out, 1
+			);
+			StoreColumn4(
+				_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+				_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+				_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+				zero, out, 2
+			);
+			StoreColumn4(
+				_mm_load_ps(lanes.Px + offset), _mm_load_ps(lanes.Py + offset), _mm_load_ps(lanes.Pz + offset),
+				one, out, 3
+			);
+		}
+	#endif
+
+	#if defined(AR_SIMD_AVX)
+		// Splits eight SoA rows in two halves and stores them like StoreColumn4
+		inline void StoreColumn8(__m256 r0, __m256 r1, __m256 r2, __m256 r3, glm::mat4* const* out, const int column)
+		{
+			StoreColumn4(
+				_mm256_castps256_ps128(r0), _mm256_castps256_ps128(r1),
+				_mm256_castps256_ps128(r2), _mm256_castps256_ps128(r3),
+				out, column
+			);
+			StoreColumn4(
+				_mm256_extractf128_ps(r0, 1), _mm256_extractf128_ps(r1, 1),
+				_mm256_extractf128_ps(r2, 1), _mm256_extractf128_ps(r3, 1),
+				out + 4, column
+			);
+		}
+
+		inline void ComposeLanes8(const TransformLanes& lanes, glm::mat4* const* out)
+		{
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 two = _mm256_set1_ps(2.0f);
+			const __m256 zero = _mm256_setzero_ps();
+
+			const __m256 x = _mm256_load_ps(lanes.Qx), y = _mm256_load_ps(lanes.Qy);
+			const __m256 z = _mm256_load_ps(lanes.Qz), w = _mm256_load_ps(lanes.Qw);
+			const __m256 sx = _mm256_load_ps(lanes.Sx), sy = _mm256_load_ps(lanes.Sy), sz = _mm256_load_ps(lanes.Sz);
+
+			const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+			const __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+			const __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+			StoreColumn8(
+				_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))), sx),
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx),
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx),
+				zero, out, 0
+			);
+			StoreColumn8(
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy),
+				_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))), sy),
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy),
+				zero, out, 1
+			);
+			StoreColumn8(
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz),
+				_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz),
+				_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))), sz),
+				zero, out, 2
+			);
+			StoreColumn8(
+				_mm256_load_ps(lanes.Px), _mm256_load_ps(lanes.Py), _mm256_load_ps(lanes.Pz),
+				one, out, 3
+			);
+		}
+	#endif
+
+		// Composes a full set of lanes with the widest kernel available
+		inline void ComposeLanes(const TransformLanes& lanes, glm::mat4* const* out)
+		{
+		#if defined(AR_SIMD_AVX)
+			ComposeLanes8(lanes, out);
+		#elif defined(AR_SIMD_SSE)
+			ComposeLanes4(lanes, 0, out);
+			ComposeLanes4(lanes, 4, out + 4);
+		#else
+			for (size_t i = 0; i < LaneCount; i++)
+				ComposeLane(lanes, i, *out[i]);
+		#endif
+		}
+
+	}
+
+	TransformSystem::TransformSystem()
+	{
+		Writes<Components::Transform>();
+		// Propagation walks the hierarchy
+		Reads<Components::Parent, Components::Children>();
+	}
+
+	void TransformSystem::OnUpdate(const Scene& scene, const Timestep& timestep)
+	{
+		EntityManager* entityManager = scene.GetEntityManager();
+
+		// Collect every dirty transform, only chunks written since the last update can hold one
+		m_DirtyTransforms.clear();
+		entityManager->Query<Components::Transform>().Where<Changed<Components::Transform>>(GetLastRunTick()).EachChunk(
+			[this](const size_t count, const uint32_t* entities, Components::Transform* transforms) {
+				for (size_t i = 0; i < count; i++)
+				{
+					if (transforms[i].m_TransformationDirty)
+						m_DirtyTransforms.push_back(&transforms[i]);
+				}
+			}
+		);
+
+		if (m_DirtyTransforms.size() >= ParallelThreshold)
+		{
+			ThreadPool::ParallelFor(m_DirtyTransforms.size(), SliceSize, [this](size_t begin, size_t end) {
+				ComputeMatrices(m_DirtyTransforms.data() + begin, end - begin);
+			});
+		}
+		else
+		{
+			ComputeMatrices(m_DirtyTransforms.data(), m_DirtyTransforms.size());
+		}
+
+		// Propagate world matrices down the hierarchy
+		std::unique_lock lock(m_Mutex);
+		// Hierarchy components can also change without SetParent (e.g. by loading a scene or applying a delta)
+		if (!m_HierarchyDirty)
+		{
+			m_HierarchyDirty = entityManager->Query<const Components::Parent>().Where<Changed<Components::Parent>>(GetLastRunTick()).Size() > 0 ||
+				entityManager->Query<const Components::Children>().Where<Changed<Components::Children>>(GetLastRunTick()).Size() > 0;
+		}
+		const uint64_t structureVersion = entityManager->GetStructureVersion();
+		if (m_HierarchyDirty || structureVersion != m_ResolvedVersion)
+		{
+			// Storage moved, a destroyed node also means the hierarchy has to be rebuilt
+			if (!m_HierarchyDirty)
+				ResolveHierarchy(entityManager);
+			if (m_HierarchyDirty)
+			{
+				RebuildHierarchy(entityManager);
+				ResolveHierarchy(entityManager);
+				// Links can also come from AddComponent, prefabs or deltas, so every node has its parent flag
+				// synced and its world matrix recomputed
+				for (size_t i = 0; i < m_Hierarchy.size(); i++)
+				{
+					Components::Transform* transform = m_NodeTransforms[i].Transform;
+					if (transform == nullptr)
+						continue;
+
+					transform->m_HasParent = m_Hierarchy[i].ParentIndex >= 0;
+					transform->m_WorldDirty = true;
+				}
+			}
+			m_ResolvedVersion = structureVersion;
+		}
+		PropagateHierarchy(entityManager->GetChangeTick());
+	}
+
+	void TransformSystem::SetParent(EntityManager* entityManager, const uint32_t entityId, const uint32_t parentId)
+	{
+		std::unique_lock lock(m_Mutex);
+		if (entityId == parentId || !entityManager->IsAlive(entityId) || (parentId != 0 && !entityManager->IsAlive(parentId)))
+		{
+			AR_CORE_WARN("Invalid entities passed to SetParent!");
+			return;
+		}
+
+		// Refuse to create cycles. A chain without cycles has at most one step per Parent component,
+		// so a longer walk means the hierarchy already has one (e.g. from a loaded scene)
+		const size_t maxDepth = entityManager->Query<const Components::Parent>().Size();
+		size_t depth = 0;
+		for (uint32_t ancestor = parentId; ancestor != 0; depth++)
+		{
+			if (ancestor == entityId)
+			{
+				AR_CORE_WARN("SetParent would create a cycle in the hierarchy!");
+				return;
+			}
+			if (depth > maxDepth)
+			{
+				AR_CORE_WARN("SetParent found a cycle in the existing hierarchy!");
+				return;
+			}
+			const Components::Parent* parent = entityManager->GetComponent<const Components::Parent>(ancestor);
+			ancestor = parent != nullptr ? parent->EntityId : 0;
+		}
+
+		// Detach from the current parent
+		const Components::Parent* currentParent = entityManager->GetComponent<const Components::Parent>(entityId);
+		if (currentParent != nullptr)
+		{
+			const uint32_t currentParentId = currentParent->EntityId;
+			Components::Children* siblings = entityManager->GetComponent<Components::Children>(currentParentId);
+			if (siblings != nullptr)
+			{
+				std::erase(siblings->EntityIds, entityId);
+				if (siblings->EntityIds.empty())
+					entityManager->RemoveComponent<Components::Children>(currentParentId);
+			}
+		}
+
+		// Attach to the new parent
+		if (parentId == 0)
+		{
+			entityManager->RemoveComponent<Components::Parent>(entityId);
+		}
+		else
+		{
+			entityManager->AddComponent<Components::Parent>(entityId, parentId);
+			Components::Children* children = entityManager->GetComponent<Components::Children>(parentId);
+			if (children == nullptr)
+				children = entityManager->AddComponent<Components::Children>(parentId);
+			children->EntityIds.push_back(entityId);
+		}
+
+		Components::Transform* transform = entityManager->GetComponent<Components::Transform>(entityId);
+		if (transform != nullptr)
+		{
+			transform->m_HasParent = parentId != 0;
+			transform->m_WorldDirty = true;
+		}
+		m_HierarchyDirty = true;
+	}
+
+	void TransformSystem::RebuildHierarchy(EntityManager* entityManager)
+	{
+		m_Hierarchy.clear();
+
+		// Roots are entities with children but no (live) parent
+		std::vector<uint32_t> parents;
+		std::vector<std::pair<uint32_t, uint32_t>> childParents;
+		entityManager->Query<const Components::Children>().Each(
+			[&parents](const uint32_t entityId, const Components::Children& children) {
+				parents.push_back(entityId);
+			}
+		);
+		entityManager->Query<const Components::Parent>().Each(
+			[&childParents](const uint32_t entityId, const Components::Parent& parent) {
+				childParents.emplace_back(entityId, parent.EntityId);
+			}
+		);
+
+		// Entities whose parent was destroyed become roots again
+		std::unordered_set<uint32_t> orphans;
+		for (const auto& [entityId, parentId] : childParents)
+		{
+			if (!entityManager->IsAlive(parentId))
+			{
+				orphans.insert(entityId);
+				Components::Transform* transform = entityManager->GetComponent<Components::Transform>(entityId);
+				if (transform != nullptr)
+					transform->m_HasParent = false;
+			}
+		}
+
+		std::unordered_set<uint32_t> visited;
+		for (const uint32_t entityId : parents)
+		{
+			if (entityManager->GetComponent<const Components::Parent>(entityId) == nullptr || orphans.contains(entityId))
+			{
+				m_Hierarchy.push_back({ entityId, -1 });
+				visited.insert(entityId);
+			}
+		}
+
+		// Breadth first, so every node comes after its parent. Each entity is only added once, which
+		// cuts cycles already present in the components (entities only reachable through a cycle are
+		// left out, like they have no root)
+		bool cycleFound = false;
+		for (size_t i = 0; i < m_Hierarchy.size(); i++)
+		{
+			const Components::Children* children = entityManager->GetComponent<const Components::Children>(m_Hierarchy[i].EntityId);
+			if (children == nullptr)
+				continue;
+
+			for (const uint32_t childId : children->EntityIds)
+			{
+				if (!entityManager->IsAlive(childId))
+					continue;
+				if (!visited.insert(childId).second)
+				{
+					cycleFound = true;
+					continue;
+				}
+				m_Hierarchy.push_back({ childId, static_cast<int32_t>(i) });
+			}
+		}
+		if (cycleFound)
+			AR_CORE_WARN("Scene hierarchy has a cycle or an entity with several parents, ignoring the extra links!");
+
+		m_NodeTransforms.resize(m_Hierarchy.size());
+		m_NodeChanged.resize(m_Hierarchy.size());
+		m_HierarchyDirty = false;
+	}
+
+	void TransformSystem::ResolveHierarchy(EntityManager* entityManager)
+	{
+		const ComponentTypeID transformType = GetComponentTypeID<Components::Transform>();
+		for (size_t i = 0; i < m_Hierarchy.size(); i++)
+		{
+			const EntityManager::ComponentLocation location = entityManager->GetComponentLocation(m_Hierarchy[i].EntityId, transformType);
+			NodeTransform& node = m_NodeTransforms[i];
+			if (location.Storage == nullptr)
+			{
+				node = NodeTransform();
+				if (!entityManager->IsAlive(m_Hierarchy[i].EntityId))
+					m_HierarchyDirty = true;
+				continue;
+			}
+
+			node.Transform = static_cast<Components::Transform*>(location.Storage->GetComponent(location.Row, location.Column));
+			node.Storage = location.Storage;
+			node.Chunk = location.Row / location.Storage->GetChunkCapacity();
+			node.Column = static_cast<size_t>(location.Column);
+		}
+	}
+
+	void TransformSystem::PropagateHierarchy(const uint32_t changeTick)
+	{
+		for (size_t i = 0; i < m_Hierarchy.size(); i++)
+		{
+			const NodeTransform& node = m_NodeTransforms[i];
+			const int32_t parentIndex = m_Hierarchy[i].ParentIndex;
+			const bool parentChanged = parentIndex >= 0 && m_NodeChanged[parentIndex];
+			const bool changed = parentChanged || (node.Transform != nullptr && node.Transform->m_WorldDirty);
+			m_NodeChanged[i] = changed;
+			if (!changed || node.Transform == nullptr)
+				continue;
+
+			// Written through the cached location, so stamp the chunk like a write access would
+			node.Storage->MarkChanged(node.Chunk, node.Column, changeTick);
+			node.Transform->m_WorldDirty = false;
+			if (parentIndex >= 0)
+			{
+				const Components::Transform* parent = m_NodeTransforms[parentIndex].Transform;
+				const glm::mat4 parentWorld = parent != nullptr ? parent->GetWorldMatrix() : glm::mat4(1.0f);
+				node.Transform->m_WorldMatrix = parentWorld * node.Transform->GetTransformationMatrix();
+			}
+		}
+	}
+
+	void TransformSystem::ComputeMatrices(Components::Transform* const* transforms, const size_t count)
+	{
+		TransformLanes lanes;
+		glm::mat4* out[LaneCount];
+
+		auto gather = [&lanes](const size_t lane, Components::Transform* transform) {
+			lanes.Px[lane] = transform->m_Position.x;
+			lanes.Py[lane] = transform->m_Position.y;
+			lanes.Pz[lane] = transform->m_Position.z;
+			lanes.Qx[lane] = transform->m_Rotation.x;
+			lanes.Qy[lane] = transform->m_Rotation.y;
+			lanes.Qz[lane] = transform->m_Rotation.z;
+			lanes.Qw[lane] = transform->m_Rotation.w;
+			lanes.Sx[lane] = transform->m_Scale.x;
+			lanes.Sy[lane] = transform->m_Scale.y;
+			lanes.Sz[lane] = transform->m_Scale.z;
+			transform->m_TransformationDirty = false;
+		};
+
+		size_t i = 0;
+		for (; i + LaneCount <= count; i += LaneCount)
+		{
+			for (size_t lane = 0; lane < LaneCount; lane++)
+			{
+				gather(lane, transforms[i + lane]);
+				out[lane] = &transforms[i + lane]->m_TransformationMatrix;
+			}
+			ComposeLanes(lanes, out);
+		}
+
+		// Remainder
+		for (; i < count; i++)
+		{
+			gather(0, transforms[i]);
+			ComposeLane(lanes, 0, transforms[i]->m_TransformationMatrix);
+		}
+	}
+
+}
\ No newline at end of file
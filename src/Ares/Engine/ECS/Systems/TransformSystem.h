@@ -0,0 +1,78 @@
+#pragma once
+#include "Engine/ECS/Core/System.h"
+
+namespace Ares::ECS {
+
+	class Archetype;
+	class EntityManager;
+
+	namespace Components {
+
+		class Transform;
+
+	}
+
+	namespace Systems {
+
+		// Computes the transformation matrix of every dirty Transform in one batched pass.
+		// Positions, rotations and scales are gathered into SIMD lanes (8 with AVX, 4 with SSE,
+		// scalar otherwise) and large batches are split across the thread pool.
+		//
+		// Afterwards world matrices are propagated down the scene hierarchy. The hierarchy is kept
+		// as a depth-sorted array (parents always come before their children), so propagation is
+		// a single linear scan that only recomputes subtrees below a changed transform. The nodes'
+		// transforms are only looked up again after a structural change moved component storage.
+		class TransformSystem : public System
+		{
+		public:
+			// Batches with at least this many dirty transforms are split across threads
+			static constexpr size_t ParallelThreshold = 4096;
+			static constexpr size_t SliceSize = 1024;
+
+		public:
+			TransformSystem();
+
+			void OnUpdate(const Scene& scene, const Timestep& timestep) override;
+
+			// Attach an entity to a parent (0 detaches it). Call outside of the scene update.
+			void SetParent(EntityManager* entityManager, const uint32_t entityId, const uint32_t parentId);
+
+		private:
+			static void ComputeMatrices(Components::Transform* const* transforms, const size_t count);
+
+			void RebuildHierarchy(EntityManager* entityManager);
+			// Looks up the transform of every node, flagging the hierarchy dirty if a node was destroyed
+			void ResolveHierarchy(EntityManager* entityManager);
+			void PropagateHierarchy(const uint32_t changeTick);
+
+		private:
+			// Entity in the depth-sorted hierarchy
+			struct HierarchyNode
+			{
+				uint32_t EntityId;
+				int32_t ParentIndex;
+			};
+
+			// Where a node's transform lives, valid until the next structural change
+			struct NodeTransform
+			{
+				Components::Transform* Transform = nullptr;
+				Archetype* Storage = nullptr;
+				size_t Chunk = 0;
+				size_t Column = 0;
+			};
+
+		private:
+			std::mutex m_Mutex;
+			std::vector<Components::Transform*> m_DirtyTransforms;
+			std::vector<HierarchyNode> m_Hierarchy;
+			std::vector<NodeTransform> m_NodeTransforms;
+			std::vector<uint8_t> m_NodeChanged;
+			bool m_HierarchyDirty = true;
+			// Structure version the node transforms were resolved at
+			uint64_t m_ResolvedVersion = 0;
+		};
+
+	}
+
+}
\ No newline at end of file
@@ -18,6 +18,10 @@ namespace Ares {
 		m_VertexBuffers[VertexDataType::Normal] = VertexBuffer::Create({ meshData->Normals.data(), meshData->Normals.size() * sizeof(float)}, BufferUsage::Static);
 		m_VertexBuffers[VertexDataType::Normal]->SetBufferLayout({ {VertexDataType::Normal} });
 		m_IndexBuffer = IndexBuffer::Create({ meshData->Indices.data(), meshData->Indices.size() * sizeof(uint32_t)}, BufferUsage::Static);
+
+		const std::vector<float>& positions = meshData->Positions;
+		for (size_t i = 0; i + 2 < positions.size(); i += 3)
+			m_Bounds.Merge(glm::vec3(positions[i], positions[i + 1], positions[i + 2]));
 	}
 
 	Scope<MeshData> MeshData::Create(const std::string& name, const Ref<ParsedMeshData>& meshData)
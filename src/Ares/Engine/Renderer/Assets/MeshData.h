@@ -1,4 +1,5 @@
 #pragma once
+#include "Engine/Core/Bounds.h"
 #include "Engine/Data/Asset.h"
 
 namespace Ares {
@@ -21,6 +22,8 @@ namespace Ares {
 		VertexBuffer* GetNormalBuffer() const;
 		VertexBuffer* GetVertexBuffer(const VertexDataType type) const;
 		IndexBuffer* GetIndexBuffer() const;
+		// Bounds of the vertex positions (in model space)
+		inline const AABB& GetBounds() const { return m_Bounds; }
 
 		// RendererID access (for low-level operations)
 		inline uint32_t GetRendererID() const { return m_RendererID; }
@@ -44,6 +47,7 @@ namespace Ares {
 		uint32_t m_RendererID;
 		std::unordered_map<VertexDataType, Scope<VertexBuffer>> m_VertexBuffers;
 		Scope<IndexBuffer> m_IndexBuffer;
+		AABB m_Bounds;
 	};
 
 }
\ No newline at end of file
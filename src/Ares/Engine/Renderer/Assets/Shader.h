@@ -6,6 +6,7 @@
 #include <glm/mat4x4.hpp>
 
 #include "Engine/Data/Asset.h"
+#include "Engine/Renderer/ShaderUniforms.h"
 
 namespace Ares {
 
@@ -57,15 +58,15 @@ namespace Ares {
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
-		// Uniform setters
-		virtual void SetInt(const std::string& name, const int32_t value) = 0;
-		virtual void SetIntArray(const std::string& name, const int32_t* values, const uint32_t count) = 0;
-		virtual void SetFloat(const std::string& name, const float value) = 0;
-		virtual void SetFloat2(const std::string& name, const glm::vec2& values) = 0;
-		virtual void SetFloat3(const std::string& name, const glm::vec3& values) = 0;
-		virtual void SetFloat4(const std::string& name, const glm::vec4& values) = 0;
-		virtual void SetMat3(const std::string& name, const glm::mat3& matrix) = 0;
-		virtual void SetMat4(const std::string& name, const glm::mat4& matrix) = 0;
+		// Uniform setters, names convert to ids so hot paths should keep static constexpr ids
+		virtual void SetInt(const UniformID id, const int32_t value) = 0;
+		virtual void SetIntArray(const UniformID id, const int32_t* values, const uint32_t count) = 0;
+		virtual void SetFloat(const UniformID id, const float value) = 0;
+		virtual void SetFloat2(const UniformID id, const glm::vec2& values) = 0;
+		virtual void SetFloat3(const UniformID id, const glm::vec3& values) = 0;
+		virtual void SetFloat4(const UniformID id, const glm::vec4& values) = 0;
+		virtual void SetMat3(const UniformID id, const glm::mat3& matrix) = 0;
+		virtual void SetMat4(const UniformID id, const glm::mat4& matrix) = 0;
 
 		// RendererID access (for low-level operations)
 		virtual uint32_t GetRendererID() const = 0;
@@ -0,0 +1,85 @@
+#include <arespch.h>
+#include "Engine/Renderer/CountingVertexBuffer.h"
+
+#include "Engine/Data/RawData.h"
+
+namespace Ares {
+
+	CountingVertexBuffer::CountingVertexBuffer(const size_t size, Scope<VertexBuffer> buffer)
+		: m_Buffer(std::move(buffer)), m_BufferSize(size)
+	{
+	}
+
+	size_t CountingVertexBuffer::GetSize() const
+	{
+		return m_BufferSize;
+	}
+
+	size_t CountingVertexBuffer::GetCount() const
+	{
+		return m_BufferSize / sizeof(float);
+	}
+
+	const BufferLayout& CountingVertexBuffer::GetBufferLayout() const
+	{
+		return m_BufferLayout;
+	}
+
+	void CountingVertexBuffer::Bind() const
+	{
+		if (m_Buffer != nullptr)
+			m_Buffer->Bind();
+	}
+
+	void CountingVertexBuffer::Unbind() const
+	{
+		if (m_Buffer != nullptr)
+			m_Buffer->Unbind();
+	}
+
+	void CountingVertexBuffer::SetData(const RawData& data, const BufferUsage usage)
+	{
+		m_BufferSize = data.Size;
+		if (data.Data != nullptr)
+		{
+			m_UploadedBytes += data.Size;
+			m_UploadCount++;
+		}
+
+		if (m_Buffer != nullptr)
+			m_Buffer->SetData(data, usage);
+	}
+
+	void CountingVertexBuffer::SetSubData(const RawData& data, const uint32_t offset)
+	{
+		if (offset + data.Size > m_BufferSize)
+		{
+			AR_CORE_ASSERT(false, "Buffer is not big enough!");
+			return;
+		}
+		m_UploadedBytes += data.Size;
+		m_UploadCount++;
+
+		if (m_Buffer != nullptr)
+			m_Buffer->SetSubData(data, offset);
+	}
+
+	void CountingVertexBuffer::SetBufferLayout(const BufferLayout& layout)
+	{
+		m_BufferLayout = layout;
+		if (m_Buffer != nullptr)
+			m_Buffer->SetBufferLayout(layout);
+	}
+
+	uint32_t CountingVertexBuffer::GetRendererID() const
+	{
+		return m_Buffer != nullptr ? m_Buffer->GetRendererID() : 0;
+	}
+
+	void CountingVertexBuffer::ResetCounters()
+	{
+		m_UploadedBytes = 0;
+		m_UploadCount = 0;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+#include "Engine/Renderer/Buffer.h"
+#include "Engine/Renderer/BufferLayout.h"
+
+namespace Ares {
+
+	// Vertex buffer that counts the bytes uploaded through SetData and SetSubData, for measuring
+	// (and asserting) how much data a system streams per frame.
+	//
+	// Every call is forwarded to the wrapped buffer. Without one, the buffer only keeps its size and
+	// layout, so upload volume can be checked without a graphics context. Reallocations without
+	// data (SetData with a null pointer) aren't counted as uploads.
+	class CountingVertexBuffer : public VertexBuffer
+	{
+	public:
+		CountingVertexBuffer(const size_t size, Scope<VertexBuffer> buffer = nullptr);
+
+		// Core properties
+		size_t GetSize() const override;
+		size_t GetCount() const override;
+		const BufferLayout& GetBufferLayout() const override;
+
+		// Binding and state
+		void Bind() const override;
+		void Unbind() const override;
+
+		// Setters
+		void SetData(const RawData& data, const BufferUsage usage = BufferUsage::Dynamic) override;
+		void SetSubData(const RawData& data, const uint32_t offset = 0) override;
+		void SetBufferLayout(const BufferLayout& layout) override;
+
+		// RendererID access (for low-level operations), 0 without a wrapped buffer
+		uint32_t GetRendererID() const override;
+
+		// Upload counters, kept until reset
+		inline size_t GetUploadedBytes() const { return m_UploadedBytes; }
+		inline size_t GetUploadCount() const { return m_UploadCount; }
+		void ResetCounters();
+
+	private:
+		Scope<VertexBuffer> m_Buffer;
+		BufferLayout m_BufferLayout;
+		size_t m_BufferSize;
+		size_t m_UploadedBytes = 0;
+		size_t m_UploadCount = 0;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <arespch.h>
+#include "Engine/Renderer/FrameRingAllocator.h"
+
+namespace Ares {
+
+	FrameRingAllocator::FrameRingAllocator(const size_t capacity, const uint32_t framesInFlight)
+		: m_Capacity(capacity), m_FramesInFlight(framesInFlight), m_FrameSizes(framesInFlight, 0)
+	{
+		AR_CORE_ASSERT(framesInFlight > 0, "A frame ring needs at least one frame in flight!");
+	}
+
+	void FrameRingAllocator::BeginFrame()
+	{
+		m_Frame++;
+
+		// The frame that used this slot is FramesInFlight frames old, its ranges are free again
+		size_t& frameSize = m_FrameSizes[m_Frame % m_FramesInFlight];
+		m_Used -= frameSize;
+		frameSize = 0;
+
+		// Nothing is in flight, so start over at the front instead of wrapping past a skipped end
+		if (m_Used == 0)
+			m_Head = 0;
+	}
+
+	size_t FrameRingAllocator::Allocate(const size_t size, const size_t alignment)
+	{
+		AR_CORE_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two!");
+
+		size_t offset = (m_Head + alignment - 1) & ~(alignment - 1);
+		size_t consumed = offset - m_Head + size;
+		if (offset + size > m_Capacity)
+		{
+			// Wrap around, the end of the ring is skipped until this frame retires
+			offset = 0;
+			consumed = m_Capacity - m_Head + size;
+		}
+
+		// Allocations are consumed in order around the ring, so this can't overlap an in-flight frame
+		if (size > m_Capacity || m_Used + consumed > m_Capacity)
+			return InvalidOffset;
+
+		m_Head = offset + size;
+		m_Used += consumed;
+		m_FrameSizes[m_Frame % m_FramesInFlight] += consumed;
+		return offset;
+	}
+
+	void FrameRingAllocator::Reset(const size_t capacity)
+	{
+		m_Capacity = capacity;
+		m_Head = 0;
+		m_Used = 0;
+		std::fill(m_FrameSizes.begin(), m_FrameSizes.end(), 0);
+	}
+
+}
\ No newline at end of file
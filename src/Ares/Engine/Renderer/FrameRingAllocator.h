@@ -0,0 +1,43 @@
+#pragma once
+
+namespace Ares {
+
+	// Sub-allocates aligned ranges of a ring buffer for data that's written once per frame.
+	//
+	// Ranges allocated during a frame stay untouched for FramesInFlight frames, so the GPU can
+	// still read them while the CPU writes the next frames, and only get recycled once BeginFrame
+	// retires their frame. The allocator only hands out offsets and doesn't touch any buffer, so the
+	// owner decides where the data goes (a UniformBuffer, a VertexBuffer or plain memory in tests).
+	class FrameRingAllocator
+	{
+	public:
+		static constexpr size_t InvalidOffset = std::numeric_limits<size_t>::max();
+
+	public:
+		FrameRingAllocator(const size_t capacity = 0, const uint32_t framesInFlight = 3);
+
+		// Core properties
+		inline size_t GetCapacity() const { return m_Capacity; }
+		inline uint32_t GetFramesInFlight() const { return m_FramesInFlight; }
+		inline uint64_t GetFrameIndex() const { return m_Frame; }
+		// Bytes held by in-flight frames, including alignment padding & the end of the ring skipped when wrapping
+		inline size_t GetUsedSize() const { return m_Used; }
+
+		// Starts the next frame, retiring the ranges of the frame FramesInFlight frames ago
+		void BeginFrame();
+		// Returns InvalidOffset when the in-flight frames leave no room
+		size_t Allocate(const size_t size, const size_t alignment);
+		// Forgets every allocation, for when the owner replaced its buffer
+		void Reset(const size_t capacity);
+
+	private:
+		size_t m_Capacity = 0;
+		uint32_t m_FramesInFlight = 0;
+		uint64_t m_Frame = 0;
+		size_t m_Head = 0;
+		size_t m_Used = 0;
+		// Bytes consumed by each in-flight frame, indexed by frame % FramesInFlight
+		std::vector<size_t> m_FrameSizes;
+	};
+
+}
\ No newline at end of file
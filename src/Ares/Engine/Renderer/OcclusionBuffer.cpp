@@ -0,0 +1,258 @@
+#include <arespch.h>
+#include "Engine/Renderer/OcclusionBuffer.h"
+
+#include "Engine/Core/SIMD.h"
+
+namespace Ares {
+
+	namespace {
+
+		// Vertices closer than this (in clip space w) count as crossing the near plane
+		constexpr float NearEpsilon = 1e-5f;
+
+	}
+
+	OcclusionBuffer::OcclusionBuffer(const uint32_t width, const uint32_t height)
+	{
+		Resize(width, height);
+	}
+
+	void OcclusionBuffer::Resize(const uint32_t width, const uint32_t height)
+	{
+		AR_CORE_ASSERT(width > 0 && height > 0, "Occlusion buffer size must not be zero!");
+		m_Width = width;
+		m_Height = height;
+
+		// Halve the size down to a single texel
+		m_Levels.clear();
+		uint32_t levelWidth = width, levelHeight = height;
+		while (true)
+		{
+			Level& level = m_Levels.emplace_back();
+			level.Width = levelWidth;
+			level.Height = levelHeight;
+			level.Stride = (levelWidth + 3) & ~3u;
+			level.Depth.assign(static_cast<size_t>(level.Stride) * levelHeight, 1.0f);
+
+			if (levelWidth == 1 && levelHeight == 1)
+				break;
+			levelWidth = (levelWidth + 1) / 2;
+			levelHeight = (levelHeight + 1) / 2;
+		}
+	}
+
+	void OcclusionBuffer::Begin(const glm::mat4& viewProjection)
+	{
+		m_ViewProjection = viewProjection;
+		std::fill(m_Levels[0].Depth.begin(), m_Levels[0].Depth.end(), 1.0f);
+	}
+
+	void OcclusionBuffer::RasterizeOccluder(
+		const glm::mat4& model,
+		const glm::vec3* vertices, const size_t vertexCount,
+		const uint32_t* indices, const size_t indexCount
+	)
+	{
+		const glm::mat4 modelViewProjection = m_ViewProjection * model;
+		const float halfWidth = 0.5f * static_cast<float>(m_Width);
+		const float halfHeight = 0.5f * static_cast<float>(m_Height);
+
+		// Project every vertex once, w is kept to reject triangles crossing the near plane
+		std::vector<glm::vec4> projected(vertexCount);
+		for (size_t i = 0; i < vertexCount; i++)
+		{
+			const glm::vec4 clip = modelViewProjection * glm::vec4(vertices[i], 1.0f);
+			if (clip.w < NearEpsilon)
+			{
+				projected[i] = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);
+				continue;
+			}
+
+			const float inverseW = 1.0f / clip.w;
+			projected[i] = glm::vec4(
+				(clip.x * inverseW + 1.0f) * halfWidth,
+				(clip.y * inverseW + 1.0f) * halfHeight,
+				clip.z * inverseW * 0.5f + 0.5f,
+				clip.w
+			);
+		}
+
+		for (size_t i = 0; i + 2 < indexCount; i += 3)
+		{
+			AR_CORE_ASSERT(indices[i] < vertexCount && indices[i + 1] < vertexCount && indices[i + 2] < vertexCount, "Occluder index out of range!");
+			const glm::vec4& v0 = projected[indices[i]];
+			const glm::vec4& v1 = projected[indices[i + 1]];
+			const glm::vec4& v2 = projected[indices[i + 2]];
+			if (v0.w < 0.0f || v1.w < 0.0f || v2.w < 0.0f)
+				continue;
+
+			RasterizeTriangle(glm::vec3(v0), glm::vec3(v1), glm::vec3(v2));
+		}
+	}
+
+	void OcclusionBuffer::RasterizeTriangle(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2)
+	{
+		// Both windings are rasterized, flip clockwise triangles
+		float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+		if (std::abs(area) < 1e-8f)
+			return;
+		const glm::vec3& a = v0;
+		const glm::vec3& b = area > 0.0f ? v1 : v2;
+		const glm::vec3& c = area > 0.0f ? v2 : v1;
+		area = std::abs(area);
+
+		// Pixel bounds, sampled at pixel centers
+		const int32_t minX = std::max(static_cast<int32_t>(std::floor(std::min({ a.x, b.x, c.x }))), 0);
+		const int32_t maxX = std::min(static_cast<int32_t>(std::ceil(std::max({ a.x, b.x, c.x }))), static_cast<int32_t>(m_Width) - 1);
+		const int32_t minY = std::max(static_cast<int32_t>(std::floor(std::min({ a.y, b.y, c.y }))), 0);
+		const int32_t maxY = std::min(static_cast<int32_t>(std::ceil(std::max({ a.y, b.y, c.y }))), static_cast<int32_t>(m_Height) - 1);
+		if (minX > maxX || minY > maxY)
+			return;
+
+		// Edge functions E(x, y) = A * x + B * y + C, positive inside the triangle. Pixels on an edge
+		// belong to both triangles sharing it, so meshes have no cracks
+		const float a0 = b.y - c.y, b0 = c.x - b.x, c0 = b.x * c.y - b.y * c.x;
+		const float a1 = c.y - a.y, b1 = a.x - c.x, c1 = c.x * a.y - c.y * a.x;
+		const float a2 = a.y - b.y, b2 = b.x - a.x, c2 = a.x * b.y - a.y * b.x;
+
+		// Depth is linear in screen space: z(x, y) = dzdx * x + dzdy * y + z0
+		const float inverseArea = 1.0f / area;
+		const float dzdx = (a0 * a.z + a1 * b.z + a2 * c.z) * inverseArea;
+		const float dzdy = (b0 * a.z + b1 * b.z + b2 * c.z) * inverseArea;
+		const float z0 = (c0 * a.z + c1 * b.z + c2 * c.z) * inverseArea;
+
+		Level& level = m_Levels[0];
+		// Rows are processed in groups of 4 pixels, the padded stride keeps the last group in bounds
+		const int32_t startX = minX & ~3;
+		for (int32_t y = minY; y <= maxY; y++)
+		{
+			const float py = static_cast<float>(y) + 0.5f;
+			float* row = level.Depth.data() + static_cast<size_t>(y) * level.Stride;
+
+		#if defined(AR_SIMD_SSE)
+			const __m128 zero = _mm_setzero_ps();
+			__m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(startX) + 0.5f), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f));
+			__m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a0), px), _mm_set1_ps(b0 * py + c0));
+			__m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a1), px), _mm_set1_ps(b1 * py + c1));
+			__m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a2), px), _mm_set1_ps(b2 * py + c2));
+			__m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(dzdx), px), _mm_set1_ps(dzdy * py + z0));
+			const __m128 e0Step = _mm_set1_ps(a0 * 4.0f), e1Step = _mm_set1_ps(a1 * 4.0f), e2Step = _mm_set1_ps(a2 * 4.0f);
+			const __m128 zStep = _mm_set1_ps(dzdx * 4.0f);
+
+			for (int32_t x = startX; x <= maxX; x += 4)
+			{
+				const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+				if (_mm_movemask_ps(inside) != 0)
+				{
+					const __m128 depth = _mm_loadu_ps(row + x);
+					const __m128 nearest = _mm_min_ps(depth, z);
+					_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, depth)));
+				}
+
+				e0 = _mm_add_ps(e0, e0Step);
+				e1 = _mm_add_ps(e1, e1Step);
+				e2 = _mm_add_ps(e2, e2Step);
+				z = _mm_add_ps(z, zStep);
+			}
+		#else
+			for (int32_t x = startX; x <= maxX; x++)
+			{
+				const float px = static_cast<float>(x) + 0.5f;
+				if (a0 * px + b0 * py + c0 >= 0.0f && a1 * px + b1 * py + c1 >= 0.0f && a2 * px + b2 * py + c2 >= 0.0f)
+					row[x] = std::min(row[x], dzdx * px + dzdy * py + z0);
+			}
+		#endif
+		}
+	}
+
+	void OcclusionBuffer::BuildHierarchy()
+	{
+		for (size_t i = 1; i < m_Levels.size(); i++)
+		{
+			const Level& source = m_Levels[i - 1];
+			Level& level = m_Levels[i];
+
+			// Each texel keeps the farthest of the (up to) 2x2 texels below it
+			for (uint32_t y = 0; y < level.Height; y++)
+			{
+				const float* row0 = source.Depth.data() + static_cast<size_t>(2 * y) * source.Stride;
+				const float* row1 = source.Depth.data() + static_cast<size_t>(std::min(2 * y + 1, source.Height - 1)) * source.Stride;
+				float* destination = level.Depth.data() + static_cast<size_t>(y) * level.Stride;
+				for (uint32_t x = 0; x < level.Width; x++)
+				{
+					const uint32_t x0 = 2 * x, x1 = std::min(2 * x + 1, source.Width - 1);
+					destination[x] = std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+				}
+			}
+		}
+	}
+
+	bool OcclusionBuffer::IsVisible(const AABB& bounds) const
+	{
+		if (!bounds.IsValid())
+			return true;
+
+		// Screen rectangle & nearest depth of the box's corners
+		float minX = std::numeric_limits<float>::max(), minY = std::numeric_limits<float>::max();
+		float maxX = std::numeric_limits<float>::lowest(), maxY = std::numeric_limits<float>::lowest();
+		float minZ = std::numeric_limits<float>::max();
+		for (uint32_t corner = 0; corner < 8; corner++)
+		{
+			const glm::vec4 clip = m_ViewProjection * glm::vec4(
+				corner & 1 ? bounds.Max.x : bounds.Min.x,
+				corner & 2 ? bounds.Max.y : bounds.Min.y,
+				corner & 4 ? bounds.Max.z : bounds.Min.z,
+				1.0f
+			);
+			if (clip.w < NearEpsilon)
+				return true;
+
+			const float inverseW = 1.0f / clip.w;
+			const float x = (clip.x * inverseW + 1.0f) * 0.5f * static_cast<float>(m_Width);
+			const float y = (clip.y * inverseW + 1.0f) * 0.5f * static_cast<float>(m_Height);
+			minX = std::min(minX, x);
+			maxX = std::max(maxX, x);
+			minY = std::min(minY, y);
+			maxY = std::max(maxY, y);
+			minZ = std::min(minZ, clip.z * inverseW * 0.5f + 0.5f);
+		}
+
+		// Off screen boxes are left to frustum culling
+		if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(m_Width) || minY >= static_cast<float>(m_Height))
+			return true;
+
+		uint32_t x0 = static_cast<uint32_t>(std::max(minX, 0.0f));
+		uint32_t y0 = static_cast<uint32_t>(std::max(minY, 0.0f));
+		uint32_t x1 = std::min(static_cast<uint32_t>(maxX), m_Width - 1);
+		uint32_t y1 = std::min(static_cast<uint32_t>(maxY), m_Height - 1);
+
+		// Go up the pyramid until the rectangle covers at most 2x2 texels
+		size_t levelIndex = 0;
+		while ((x1 - x0 > 1 || y1 - y0 > 1) && levelIndex + 1 < m_Levels.size())
+		{
+			x0 /= 2;
+			y0 /= 2;
+			x1 /= 2;
+			y1 /= 2;
+			levelIndex++;
+		}
+
+		const Level& level = m_Levels[levelIndex];
+		for (uint32_t y = y0; y <= y1; y++)
+		{
+			for (uint32_t x = x0; x <= x1; x++)
+			{
+				if (minZ <= level.Depth[static_cast<size_t>(y) * level.Stride + x])
+					return true;
+			}
+		}
+		return false;
+	}
+
+	float OcclusionBuffer::GetDepth(const size_t level, const uint32_t x, const uint32_t y) const
+	{
+		AR_CORE_ASSERT(level < m_Levels.size() && x < m_Levels[level].Width && y < m_Levels[level].Height, "Occlusion buffer texel out of range!");
+		return m_Levels[level].Depth[static_cast<size_t>(y) * m_Levels[level].Stride + x];
+	}
+
+}
\ No newline at end of file
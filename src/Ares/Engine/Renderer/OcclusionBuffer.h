@@ -0,0 +1,65 @@
+#pragma once
+#include <glm/mat4x4.hpp>
+
+#include "Engine/Core/Bounds.h"
+
+namespace Ares {
+
+	// Low resolution, depth-only software rasterizer for occlusion culling.
+	//
+	// Occluder triangles are rasterized on the CPU (4 pixels at a time with SSE) into a depth buffer
+	// that keeps the nearest occluder depth per pixel. A hierarchical-Z pyramid is then built on top
+	// of it, each texel holding the farthest depth of the 2x2 texels below, so a bounding box can be
+	// tested against at most a few texels of the level matching its screen size.
+	//
+	// Everything is conservative: triangles crossing the near plane aren't rasterized and boxes
+	// crossing it are always visible. Nothing here touches the GPU.
+	class OcclusionBuffer
+	{
+	public:
+		OcclusionBuffer(const uint32_t width = 256, const uint32_t height = 128);
+
+		// Core properties
+		inline uint32_t GetWidth() const { return m_Width; }
+		inline uint32_t GetHeight() const { return m_Height; }
+		inline size_t GetLevelCount() const { return m_Levels.size(); }
+
+		void Resize(const uint32_t width, const uint32_t height);
+
+		// Clears the depth buffer and sets the view projection matrix used by the following calls
+		void Begin(const glm::mat4& viewProjection);
+		// Rasterizes an indexed triangle list, transformed by a model matrix
+		void RasterizeOccluder(
+			const glm::mat4& model,
+			const glm::vec3* vertices, const size_t vertexCount,
+			const uint32_t* indices, const size_t indexCount
+		);
+		// Builds the hierarchical-Z pyramid, call once every occluder has been rasterized
+		void BuildHierarchy();
+
+		// Checks if any part of a world space box could be in front of the occluders
+		bool IsVisible(const AABB& bounds) const;
+		// Depth (0 near, 1 far) of a texel of a pyramid level, level 0 being the full resolution buffer
+		float GetDepth(const size_t level, const uint32_t x, const uint32_t y) const;
+
+	private:
+		// Screen space vertices (x & y in pixels, z in [0, 1])
+		void RasterizeTriangle(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2);
+
+	private:
+		struct Level
+		{
+			uint32_t Width = 0;
+			uint32_t Height = 0;
+			// Rows are padded to a multiple of 4 texels
+			uint32_t Stride = 0;
+			std::vector<float> Depth;
+		};
+
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+		glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+		std::vector<Level> m_Levels;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include <arespch.h>
+#include "Engine/Renderer/RenderQueue.h"
+
+namespace Ares {
+
+	namespace {
+
+		constexpr size_t RadixBits = 8;
+		constexpr size_t RadixBuckets = 1 << RadixBits;
+		constexpr size_t RadixPasses = 64 / RadixBits;
+		// Below this, insertion sort beats the histogram passes
+		constexpr size_t InsertionSortThreshold = 64;
+
+	}
+
+	uint64_t RenderQueue::MakeKey(const Pass pass, const bool translucent, const uint32_t shaderId, const uint32_t materialId, const uint32_t meshId, const float depth)
+	{
+		AR_CORE_ASSERT(shaderId <= MaxShaderId && materialId <= MaxMaterialId && meshId <= MaxMeshId, "Render queue id out of range!");
+
+		const uint64_t quantizedDepth = static_cast<uint64_t>(std::clamp(depth, 0.0f, 1.0f) * 65535.0f);
+		const uint64_t state = (static_cast<uint64_t>(shaderId) << 31) | (static_cast<uint64_t>(materialId) << 15) | meshId;
+
+		uint64_t key = static_cast<uint64_t>(pass) << 62;
+		if (translucent)
+			key |= (1ull << 61) | ((0xffffull - quantizedDepth) << 45) | state;
+		else
+			key |= (state << 16) | quantizedDepth;
+		return key;
+	}
+
+	void RenderQueue::Sort()
+	{
+		const size_t count = m_Entries.size();
+		if (count < InsertionSortThreshold)
+		{
+			for (size_t i = 1; i < count; i++)
+			{
+				const Entry entry = m_Entries[i];
+				size_t j = i;
+				for (; j > 0 && m_Entries[j - 1].Key > entry.Key; j--)
+					m_Entries[j] = m_Entries[j - 1];
+				m_Entries[j] = entry;
+			}
+			return;
+		}
+
+		// Histograms of every byte in a single read
+		uint32_t histograms[RadixPasses][RadixBuckets] = {};
+		for (const Entry& entry : m_Entries)
+		{
+			for (size_t pass = 0; pass < RadixPasses; pass++)
+				histograms[pass][(entry.Key >> (pass * RadixBits)) & (RadixBuckets - 1)]++;
+		}
+
+		m_Scratch.resize(count);
+		Entry* source = m_Entries.data();
+		Entry* destination = m_Scratch.data();
+		for (size_t pass = 0; pass < RadixPasses; pass++)
+		{
+			uint32_t* histogram = histograms[pass];
+			const size_t shift = pass * RadixBits;
+
+			// Every key has the same byte, the pass wouldn't change the order
+			if (histogram[(source[0].Key >> shift) & (RadixBuckets - 1)] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (size_t bucket = 0; bucket < RadixBuckets; bucket++)
+			{
+				const uint32_t bucketCount = histogram[bucket];
+				histogram[bucket] = offset;
+				offset += bucketCount;
+			}
+
+			for (size_t i = 0; i < count; i++)
+				destination[histogram[(source[i].Key >> shift) & (RadixBuckets - 1)]++] = source[i];
+
+			std::swap(source, destination);
+		}
+
+		if (source != m_Entries.data())
+			m_Entries.swap(m_Scratch);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+namespace Ares {
+
+	// List of draws sorted by packed 64-bit keys.
+	//
+	// Keys are laid out so sorting them puts draws in submission order: by pass, opaque before
+	// translucent, then opaque draws by shader, material & mesh (front to back within the same
+	// state) and translucent draws back to front. From most to least significant bit:
+	//
+	//   Opaque:      pass (2) | 0 | shader (14) | material (16) | mesh (15) | depth (16)
+	//   Translucent: pass (2) | 1 | ~depth (16) | shader (14) | material (16) | mesh (15)
+	//
+	// Shader, material & mesh are small dense ids, so a change in their bits always is a change of
+	// state and the draw loop only has to rebind when they differ from the previous draw. Keys are
+	// sorted with an LSD radix sort (8 bits per pass), skipping passes where every key has the same byte.
+	class RenderQueue
+	{
+	public:
+		enum class Pass : uint8_t
+		{
+			Forward = 0
+		};
+
+		struct Entry
+		{
+			uint64_t Key;
+			// Index of the draw in the caller's data
+			uint32_t Index;
+		};
+
+		static constexpr uint32_t MaxShaderId = (1u << 14) - 1;
+		static constexpr uint32_t MaxMaterialId = (1u << 16) - 1;
+		static constexpr uint32_t MaxMeshId = (1u << 15) - 1;
+
+	public:
+		// Depth is normalized, 0 being at the camera & 1 at the far plane
+		static uint64_t MakeKey(const Pass pass, const bool translucent, const uint32_t shaderId, const uint32_t materialId, const uint32_t meshId, const float depth);
+
+		static inline Pass GetPass(const uint64_t key) { return static_cast<Pass>(key >> 62); }
+		static inline bool IsTranslucent(const uint64_t key) { return (key >> 61) & 1; }
+		static inline uint32_t GetShaderId(const uint64_t key) { return static_cast<uint32_t>(key >> (IsTranslucent(key) ? 31 : 47)) & MaxShaderId; }
+		static inline uint32_t GetMaterialId(const uint64_t key) { return static_cast<uint32_t>(key >> (IsTranslucent(key) ? 15 : 31)) & MaxMaterialId; }
+		static inline uint32_t GetMeshId(const uint64_t key) { return static_cast<uint32_t>(key >> (IsTranslucent(key) ? 0 : 16)) & MaxMeshId; }
+
+		inline void Clear() { m_Entries.clear(); }
+		inline void Push(const uint64_t key, const uint32_t index) { m_Entries.push_back({ key, index }); }
+		void Sort();
+
+		inline const std::vector<Entry>& GetEntries() const { return m_Entries; }
+		inline size_t Size() const { return m_Entries.size(); }
+
+	private:
+		std::vector<Entry> m_Entries;
+		// Radix sort ping-pong buffer
+		std::vector<Entry> m_Scratch;
+	};
+
+}
\ No newline at end of file
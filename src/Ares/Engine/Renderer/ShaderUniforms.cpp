@@ -0,0 +1,21 @@
+#include <arespch.h>
+#include "Engine/Renderer/ShaderUniforms.h"
+
+namespace Ares {
+
+	void UniformLocationTable::Add(const std::string_view name, const int32_t location)
+	{
+		const UniformID id(name);
+		auto [entry, inserted] = m_Locations.TryEmplace(id.GetValue(), location);
+		if (!inserted && entry->second != location)
+		{
+			AR_CORE_WARN("Uniform '{}' has the same id as another uniform of the program - Ignoring it!", name);
+			return;
+		}
+
+		constexpr std::string_view firstElement = "[0]";
+		if (name.size() > firstElement.size() && name.ends_with(firstElement))
+			Add(name.substr(0, name.size() - firstElement.size()), location);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+#include "Engine/Core/FlatMap.h"
+
+namespace Ares {
+
+	// Handle of a uniform name: the 32-bit FNV-1a hash of the name.
+	//
+	// Names known up front are hashed at compile time (static constexpr UniformID), other strings
+	// convert implicitly, so setting a uniform never goes through the name again.
+	class UniformID
+	{
+	public:
+		constexpr UniformID() = default;
+		constexpr UniformID(const std::string_view name) : m_Value(Hash(name)) {}
+		constexpr UniformID(const char* name) : m_Value(Hash(name)) {}
+		UniformID(const std::string& name) : m_Value(Hash(name)) {}
+
+		static constexpr UniformID FromValue(const uint32_t value)
+		{
+			UniformID id;
+			id.m_Value = value;
+			return id;
+		}
+
+		inline constexpr uint32_t GetValue() const { return m_Value; }
+		inline constexpr bool operator==(const UniformID& other) const { return m_Value == other.m_Value; }
+
+		static constexpr uint32_t Hash(const std::string_view name)
+		{
+			uint32_t hash = 2166136261u;
+			for (const char c : name)
+			{
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 16777619u;
+			}
+			return hash;
+		}
+
+	private:
+		uint32_t m_Value = 0;
+	};
+
+	// Locations of a linked program's active uniforms, filled once after linking so setting a
+	// uniform is a table lookup instead of a driver query. Doesn't touch the graphics API.
+	class UniformLocationTable
+	{
+	public:
+		static constexpr int32_t InvalidLocation = -1;
+
+	public:
+		// Array elements are passed one by one, the first one is also added under the base name
+		// ("u_Values[0]" as "u_Values") like the API resolves it
+		void Add(const std::string_view name, const int32_t location);
+		inline void Clear() { m_Locations.Clear(); }
+
+		// InvalidLocation for names the program doesn't use, which setters silently ignore
+		inline int32_t GetLocation(const UniformID id) const
+		{
+			const int32_t* location = m_Locations.Find(id.GetValue());
+			return location != nullptr ? *location : InvalidLocation;
+		}
+		inline size_t Size() const { return m_Locations.Size(); }
+
+	private:
+		FlatMap<uint32_t, int32_t> m_Locations;
+	};
+
+}
\ No newline at end of file
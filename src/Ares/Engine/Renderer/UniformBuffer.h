@@ -5,6 +5,10 @@ namespace Ares {
 
 	class UniformBuffer
 	{
+	public:
+		// Largest offset alignment any implementation may require for BindRange
+		static constexpr size_t UniformOffsetAlignment = 256;
+
 	public:
 		virtual ~UniformBuffer() = default;
 
@@ -15,6 +19,8 @@ namespace Ares {
 		// Binding and state
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
+		// Binds part of the buffer to the binding point, offset must be a multiple of UniformOffsetAlignment
+		virtual void BindRange(const size_t offset, const size_t size) const = 0;
 
 		// Setters
 		virtual void SetData(const RawData& data, const BufferUsage usage = BufferUsage::Dynamic) = 0;
@@ -18,6 +18,7 @@ namespace Ares {
 }
 
 // Ares related hashes
+// Materials & meshes cache these as their batch key, use GetBatchKey() instead of hashing them again
 template<>
 struct std::hash<Ares::ECS::Components::Material>
 {
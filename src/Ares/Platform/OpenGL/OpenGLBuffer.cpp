@@ -51,12 +51,11 @@ namespace Ares {
 
 	void OpenGLVertexBuffer::SetSubData(const RawData& data, const uint32_t offset)
 	{
-		if (data.Size > m_BufferSize)
+		if (offset + data.Size > m_BufferSize)
 		{
 			AR_CORE_ASSERT(false, "Buffer is not big enough!");
 			return;
 		}
-		m_BufferCount = data.Size / sizeof(float);
 		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 		glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(data.Size), data.Data);
 	}
@@ -137,6 +137,45 @@ namespace Ares {
 		{
 			glDetachShader(m_RendererID, shader->GetRendererID());
 		}
+
+		ReflectUniforms();
+	}
+
+	void OpenGLShaderProgram::ReflectUniforms()
+	{
+		m_Uniforms.Clear();
+
+		GLint uniformCount = 0;
+		GLint maxNameLength = 0;
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &uniformCount);
+		glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+		std::vector<GLchar> nameBuffer(std::max(maxNameLength, 1));
+		for (GLint index = 0; index < uniformCount; index++)
+		{
+			GLsizei nameLength = 0;
+			GLint arraySize = 0;
+			GLenum type = 0;
+			glGetActiveUniform(m_RendererID, static_cast<GLuint>(index), static_cast<GLsizei>(nameBuffer.size()), &nameLength, &arraySize, &type, nameBuffer.data());
+
+			// Uniforms inside blocks have no location
+			const std::string name(nameBuffer.data(), nameLength);
+			const GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+			if (location < 0)
+				continue;
+			m_Uniforms.Add(name, location);
+
+			// Arrays are reported by their first element, the others get their own locations
+			if (arraySize > 1 && name.ends_with("[0]"))
+			{
+				const std::string baseName = name.substr(0, name.size() - 3);
+				for (GLint element = 1; element < arraySize; element++)
+				{
+					const std::string elementName = baseName + "[" + std::to_string(element) + "]";
+					m_Uniforms.Add(elementName, glGetUniformLocation(m_RendererID, elementName.c_str()));
+				}
+			}
+		}
 	}
 
 	void OpenGLShaderProgram::Bind() const
@@ -149,91 +188,91 @@ namespace Ares {
 		glUseProgram(0);
 	}
 
-	void OpenGLShaderProgram::SetInt(const std::string& name, const int32_t value)
+	void OpenGLShaderProgram::SetInt(const UniformID id, const int32_t value)
 	{
-		UploadUniformInt(name, static_cast<GLint>(value));
+		UploadUniformInt(id, static_cast<GLint>(value));
 	}
 
-	void OpenGLShaderProgram::SetIntArray(const std::string& name, const int32_t* values, const uint32_t count)
+	void OpenGLShaderProgram::SetIntArray(const UniformID id, const int32_t* values, const uint32_t count)
 	{
-		UploadUniformIntArray(name, static_cast<const GLint*>(values), static_cast<GLsizei>(count));
+		UploadUniformIntArray(id, static_cast<const GLint*>(values), static_cast<GLsizei>(count));
 	}
 
-	void OpenGLShaderProgram::SetFloat(const std::string& name, const float value)
+	void OpenGLShaderProgram::SetFloat(const UniformID id, const float value)
 	{
-		UploadUniformFloat(name, static_cast<GLfloat>(value));
+		UploadUniformFloat(id, static_cast<GLfloat>(value));
 	}
 
-	void OpenGLShaderProgram::SetFloat2(const std::string& name, const glm::vec2& values)
+	void OpenGLShaderProgram::SetFloat2(const UniformID id, const glm::vec2& values)
 	{
-		UploadUniformFloat2(name, static_cast<GLfloat>(values.x), static_cast<GLfloat>(values.y));
+		UploadUniformFloat2(id, static_cast<GLfloat>(values.x), static_cast<GLfloat>(values.y));
 	}
 
-	void OpenGLShaderProgram::SetFloat3(const std::string& name, const glm::vec3& values)
+	void OpenGLShaderProgram::SetFloat3(const UniformID id, const glm::vec3& values)
 	{
-		UploadUniformFloat3(name, static_cast<GLfloat>(values.x), static_cast<GLfloat>(values.y), static_cast<GLfloat>(values.z));
+		UploadUniformFloat3(id, static_cast<GLfloat>(values.x), static_cast<GLfloat>(values.y), static_cast<GLfloat>(values.z));
 	}
 
-	void OpenGLShaderProgram::SetFloat4(const std::string& name, const glm::vec4& values)
+	void OpenGLShaderProgram::SetFloat4(const UniformID id, const glm::vec4& values)
 	{
-		UploadUniformFloat4(name, static_cast<GLfloat>(values.x), static_cast<GLfloat>(values.y), static_cast<GLfloat>(values.z), static_cast<GLfloat>(values.w));
+		UploadUniformFloat4(id, static_cast<GLfloat>(values.x), static_cast<GLfloat>(values.y), static_cast<GLfloat>(values.z), static_cast<GLfloat>(values.w));
 	}
 
-	void OpenGLShaderProgram::SetMat3(const std::string& name, const glm::mat3& matrix)
+	void OpenGLShaderProgram::SetMat3(const UniformID id, const glm::mat3& matrix)
 	{
-		UploadUniformMat3(name, static_cast<const GLfloat*>(glm::value_ptr(matrix)));
+		UploadUniformMat3(id, static_cast<const GLfloat*>(glm::value_ptr(matrix)));
 	}
 
-	void OpenGLShaderProgram::SetMat4(const std::string& name, const glm::mat4& matrix)
+	void OpenGLShaderProgram::SetMat4(const UniformID id, const glm::mat4& matrix)
 	{
-		UploadUniformMat4(name, static_cast<const GLfloat*>(glm::value_ptr(matrix)));
+		UploadUniformMat4(id, static_cast<const GLfloat*>(glm::value_ptr(matrix)));
 	}
 
-	void OpenGLShaderProgram::UploadUniformInt(const std::string& name, GLint value)
+	void OpenGLShaderProgram::UploadUniformInt(const UniformID id, GLint value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = m_Uniforms.GetLocation(id);
 		glUniform1i(location, value);
 	}
 
-	void OpenGLShaderProgram::UploadUniformIntArray(const std::string& name, const GLint* values, const GLsizei count)
+	void OpenGLShaderProgram::UploadUniformIntArray(const UniformID id, const GLint* values, const GLsizei count)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = m_Uniforms.GetLocation(id);
 		glUniform1iv(location, count, values);
 	}
 
-	void OpenGLShaderProgram::UploadUniformFloat(const std::string& name, GLfloat value)
+	void OpenGLShaderProgram::UploadUniformFloat(const UniformID id, GLfloat value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = m_Uniforms.GetLocation(id);
 		glUniform1f(location, value);
 	}
 
-	void OpenGLShaderProgram::UploadUniformFloat2(const std::string& name, GLfloat v0, GLfloat v1)
+	void OpenGLShaderProgram::UploadUniformFloat2(const UniformID id, GLfloat v0, GLfloat v1)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = m_Uniforms.GetLocation(id);
 		glUniform2f(location, v0, v1);
 	}
 
-	void OpenGLShaderProgram::UploadUniformFloat3(const std::string& name, GLfloat v0, GLfloat v1, GLfloat v2)
+	void OpenGLShaderProgram::UploadUniformFloat3(const UniformID id, GLfloat v0, GLfloat v1, GLfloat v2)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = m_Uniforms.GetLocation(id);
 		glUniform3f(location, v0, v1, v2);
 	}
 
-	void OpenGLShaderProgram::UploadUniformFloat4(const std::string& name, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+	void OpenGLShaderProgram::UploadUniformFloat4(const UniformID id, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = m_Uniforms.GetLocation(id);
 		glUniform4f(location, v0, v1, v2, v3);
 	}
 
-	void OpenGLShaderProgram::UploadUniformMat3(const std::string& name, const GLfloat* values)
+	void OpenGLShaderProgram::UploadUniformMat3(const UniformID id, const GLfloat* values)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = m_Uniforms.GetLocation(id);
 		glUniformMatrix3fv(location, 1, GL_FALSE, values);
 	}
 
-	void OpenGLShaderProgram::UploadUniformMat4(const std::string& name, const GLfloat* values)
+	void OpenGLShaderProgram::UploadUniformMat4(const UniformID id, const GLfloat* values)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+		GLint location = m_Uniforms.GetLocation(id);
 		glUniformMatrix4fv(location, 1, GL_FALSE, values);
 	}
 
@@ -70,14 +70,14 @@ namespace Ares {
 		void Unbind() const override;
 
 		// Uniform setters
-		void SetInt(const std::string& name, const int32_t value) override;
-		void SetIntArray(const std::string& name, const int32_t* values, const uint32_t count) override;
-		void SetFloat(const std::string& name, const float value) override;
-		void SetFloat2(const std::string& name, const glm::vec2& values) override;
-		void SetFloat3(const std::string& name, const glm::vec3& values) override;
-		void SetFloat4(const std::string& name, const glm::vec4& values) override;
-		void SetMat3(const std::string& name, const glm::mat3& matrix) override;
-		void SetMat4(const std::string& name, const glm::mat4& matrix) override;
+		void SetInt(const UniformID id, const int32_t value) override;
+		void SetIntArray(const UniformID id, const int32_t* values, const uint32_t count) override;
+		void SetFloat(const UniformID id, const float value) override;
+		void SetFloat2(const UniformID id, const glm::vec2& values) override;
+		void SetFloat3(const UniformID id, const glm::vec3& values) override;
+		void SetFloat4(const UniformID id, const glm::vec4& values) override;
+		void SetMat3(const UniformID id, const glm::mat3& matrix) override;
+		void SetMat4(const UniformID id, const glm::mat4& matrix) override;
 
 		// Renderer ID access (for low-level operations)
 		inline uint32_t GetRendererID() const override { return static_cast<uint32_t>(m_RendererID); }
@@ -85,18 +85,21 @@ namespace Ares {
 	private:
 		// Utilities
 		void LinkShaders(const std::vector<Shader*>& shaders);
-		void UploadUniformInt(const std::string& name, const GLint value);
-		void UploadUniformIntArray(const std::string& name, const GLint* values, const GLsizei count);
-		void UploadUniformFloat(const std::string& name, GLfloat value);
-		void UploadUniformFloat2(const std::string& name, GLfloat v0, GLfloat v1);
-		void UploadUniformFloat3(const std::string& name, GLfloat v0, GLfloat v1, GLfloat v2);
-		void UploadUniformFloat4(const std::string& name, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
-		void UploadUniformMat3(const std::string& name, const GLfloat* values);
-		void UploadUniformMat4(const std::string& name, const GLfloat* values);
+		// Looks up the locations of every active uniform once, after linking
+		void ReflectUniforms();
+		void UploadUniformInt(const UniformID id, const GLint value);
+		void UploadUniformIntArray(const UniformID id, const GLint* values, const GLsizei count);
+		void UploadUniformFloat(const UniformID id, GLfloat value);
+		void UploadUniformFloat2(const UniformID id, GLfloat v0, GLfloat v1);
+		void UploadUniformFloat3(const UniformID id, GLfloat v0, GLfloat v1, GLfloat v2);
+		void UploadUniformFloat4(const UniformID id, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+		void UploadUniformMat3(const UniformID id, const GLfloat* values);
+		void UploadUniformMat4(const UniformID id, const GLfloat* values);
 
 	private:
 		std::string m_Name;
 		GLuint m_RendererID;
+		UniformLocationTable m_Uniforms;
 	};
 
 }
\ No newline at end of file
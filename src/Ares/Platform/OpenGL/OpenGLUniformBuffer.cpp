@@ -52,6 +52,16 @@ namespace Ares {
 		glBindBuffer(GL_UNIFORM_BUFFER, 0);
 	}
 
+	void OpenGLUniformBuffer::BindRange(const size_t offset, const size_t size) const
+	{
+		if (offset + size > m_BufferSize)
+		{
+			AR_CORE_ASSERT(false, "Buffer Overflow!");
+			return;
+		}
+		glBindBufferRange(GL_UNIFORM_BUFFER, m_BindingPoint, m_RendererID, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+	}
+
 	void OpenGLUniformBuffer::SetData(const RawData& data, const BufferUsage usage)
 	{
 		m_BufferSize = data.Size;
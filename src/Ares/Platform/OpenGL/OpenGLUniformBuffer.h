@@ -19,6 +19,7 @@ namespace Ares {
 		// Binding and state
 		void Bind() const override;
 		void Unbind() const override;
+		void BindRange(const size_t offset, const size_t size) const override;
 
 		// Setters
 		void SetData(const RawData& data, const BufferUsage usage = BufferUsage::Dynamic) override;
@@ -12,6 +12,7 @@
 #include <sstream>				// String streams
 #include <array>				// Fixed-size arrays
 #include <vector>				// Dynamic arrays
+#include <map>					// Ordered map
 #include <unordered_map>		// Hash map
 #include <unordered_set>		// Hash set
 #include <functional>			// Function objects
@@ -21,6 +22,7 @@
 #include <regex>				// Regular expressions
 #include <variant>				// Utility library
 #include <type_traits>			// Metaprogramming
+#include <utility>				// Move & exchange
 #include <cstdio>				// C standard library
 #include <stdio.h>				// Generic file operation
 
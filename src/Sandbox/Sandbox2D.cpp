@@ -17,7 +17,10 @@ Sandbox2D::Sandbox2D()
 	m_SandboxScene->RegisterSystem<Systems::CameraSystem>();
 	m_SandboxScene->RegisterSystem<Systems::RenderSystem>();
 	m_SandboxScene->RegisterSystem<Systems::LightSystem>();
-	m_SandboxScene->SetSystemUpdateOrder<Systems::CameraSystem, Systems::LightSystem, Systems::RenderSystem>();
+	m_SandboxScene->RegisterSystem<Systems::TransformSystem>();
+	m_SandboxScene->RegisterSystem<Systems::SpatialIndexSystem>();
+	m_SandboxScene->RegisterSystem<Systems::LODSystem>();
+	m_SandboxScene->SetSystemUpdateOrder<Systems::TransformSystem, Systems::SpatialIndexSystem, Systems::CameraSystem, Systems::LODSystem, Systems::LightSystem, Systems::RenderSystem>();
 	m_SandboxScene->SetSystemRenderOrder<Systems::RenderSystem>();
 
 	m_EntityListElement.SetScene(m_SandboxScene.get());
@@ -159,8 +162,9 @@ void Sandbox2D::CreateLightEntity()
 	EntityManager* entityManager = m_SandboxScene->GetEntityManager();
 
 	m_LightEntity = entityManager->CreateEntity();
-	Components::Light* lightComponent = m_LightEntity.AddComponent<Components::Light>();
+	m_LightEntity.AddComponent<Components::Light>();
 	Components::Transform* lightTransform = m_LightEntity.AddComponent<Components::Transform>();
+	Components::Light* lightComponent = m_LightEntity.GetComponent<Components::Light>();
 	lightComponent->SetColor({ 1.0f, 1.0f, 1.0f });
 	lightComponent->SetType(Components::Light::Point);
 	lightComponent->SetRange(10.0f);
@@ -201,8 +205,9 @@ void Sandbox2D::CreateQuadMeshEntities()
 
 		m_SquareEntity = entityManager->CreateEntity();
 		m_SquareEntity.AddComponent<Components::Mesh>(quadMeshAsset);
-		Components::Material* quad1Material = m_SquareEntity.AddComponent<Components::Material>();
+		m_SquareEntity.AddComponent<Components::Material>();
 		Components::Transform* quad1Transform = m_SquareEntity.AddComponent<Components::Transform>();
+		Components::Material* quad1Material = m_SquareEntity.GetComponent<Components::Material>();
 		Components::MaterialProperties props;
 		props.Basic.Color = { 1.0f, 1.0f, 0.0f };
 		quad1Material->SetProperties(props);
@@ -212,8 +217,9 @@ void Sandbox2D::CreateQuadMeshEntities()
 
 		m_SquareEntity2 = entityManager->CreateEntity();
 		m_SquareEntity2.AddComponent<Components::Mesh>(quadMeshAsset);
-		Components::Material* quad2Material = m_SquareEntity2.AddComponent<Components::Material>();
+		m_SquareEntity2.AddComponent<Components::Material>();
 		Components::Transform* quad2Transform = m_SquareEntity2.AddComponent<Components::Transform>();
+		Components::Material* quad2Material = m_SquareEntity2.GetComponent<Components::Material>();
 		Components::MaterialProperties props2;
 		props2.Basic.Color = { 1.0f, 0.0f, 0.0f };
 		props2.Basic.Alpha = 1.0f;
@@ -98,11 +98,11 @@ void EntityListElement::Draw()
 		for (auto& [entityId, componentVec] : m_ComponentMap)
 		{
 			const char* icon = ICON_MD_VIEW_IN_AR;
-			for (std::type_index& component : componentVec)
+			for (const Ares::ECS::ComponentTypeID component : componentVec)
 			{
-				if (component == typeid(Ares::ECS::Components::Camera))
+				if (component == Ares::ECS::GetComponentTypeID<Ares::ECS::Components::Camera>())
 					icon = ICON_MD_VIDEOCAM;
-				if (component == typeid(Ares::ECS::Components::Light))
+				if (component == Ares::ECS::GetComponentTypeID<Ares::ECS::Components::Light>())
 					icon = ICON_MD_LIGHT_MODE;
 			}
 			std::string entityName = entityManager->GetEntityName(entityId);
@@ -124,13 +124,13 @@ void EntityListElement::Draw()
 	ImGui::Begin("Entity Properties");
 	if (m_CurrentEntity != 0)
 	{
-		std::vector<std::type_index>& componentVec = m_ComponentMap[m_CurrentEntity];
-		for (std::type_index& type : componentVec)
+		std::vector<Ares::ECS::ComponentTypeID>& componentVec = m_ComponentMap[m_CurrentEntity];
+		for (const Ares::ECS::ComponentTypeID type : componentVec)
 		{
 			std::string label;
 			std::vector<std::string> componentInfo;
 			std::function<void()> infoCallback = nullptr;
-			if (type == typeid(Ares::ECS::Components::Camera))
+			if (type == Ares::ECS::GetComponentTypeID<Ares::ECS::Components::Camera>())
 			{
 				label = "Camera";
 				infoCallback = [=]() {
@@ -244,7 +244,7 @@ void EntityListElement::Draw()
 					}
 				};
 			}
-			else if (type == typeid(Ares::ECS::Components::Mesh))
+			else if (type == Ares::ECS::GetComponentTypeID<Ares::ECS::Components::Mesh>())
 			{
 				label = "Mesh";
 				infoCallback = [=]() {
@@ -274,7 +274,7 @@ void EntityListElement::Draw()
 					}
 				};
 			}
-			else if (type == typeid(Ares::ECS::Components::Material))
+			else if (type == Ares::ECS::GetComponentTypeID<Ares::ECS::Components::Material>())
 			{
 				label = "Material";
 				infoCallback = [=]() {
@@ -386,7 +386,7 @@ void EntityListElement::Draw()
 					}
 				};
 			}
-			else if (type == typeid(Ares::ECS::Components::Transform))
+			else if (type == Ares::ECS::GetComponentTypeID<Ares::ECS::Components::Transform>())
 			{
 				label = "Transform";
 				infoCallback = [=]() {
@@ -456,7 +456,7 @@ void EntityListElement::Draw()
 					}
 				};
 			}
-			else if (type == typeid(Ares::ECS::Components::Light))
+			else if (type == Ares::ECS::GetComponentTypeID<Ares::ECS::Components::Light>())
 			{
 				label = "Light";
 				infoCallback = [=]() {
@@ -618,25 +618,17 @@ void EntityListElement::OnUpdate(const Ares::Timestep& ts)
 	if (m_CurrentScene != nullptr)
 	{
 		Ares::ECS::EntityManager* entityManager = m_CurrentScene->GetEntityManager();
-		auto& componentMap = entityManager->GetEntityComponents();
+		const std::vector<uint32_t> entities = entityManager->GetEntities();
+		const std::unordered_set<uint32_t> liveEntities(entities.begin(), entities.end());
 
-		// Iterate through the Entity Manager map
-		for (const auto& [entityId, components] : componentMap)
+		// Iterate through the Entity Manager entities
+		for (const uint32_t entityId : entities)
 		{
 			// Get or create the entry in the local map
-			std::vector<std::type_index>& typeIndices = m_ComponentMap[entityId];
+			std::vector<Ares::ECS::ComponentTypeID>& typeIndices = m_ComponentMap[entityId];
 
-			// Create a temporary vector of type indices from the Entity Manager map
-			std::vector<std::type_index> newTypeIndices;
-			newTypeIndices.reserve(components.size());
-			for (const auto& [typeIndex, _] : components)
-			{
-				newTypeIndices.push_back(typeIndex);
-			}
-
-			// Sort both vectors for comparison (std::unordered_map does not guarantee order)
-			std::sort(typeIndices.begin(), typeIndices.end());
-			std::sort(newTypeIndices.begin(), newTypeIndices.end());
+			// Archetype signatures are already sorted
+			std::vector<Ares::ECS::ComponentTypeID> newTypeIndices = entityManager->GetComponentTypes(entityId);
 
 			// Update only if there is a difference
 			if (typeIndices != newTypeIndices)
@@ -646,10 +638,10 @@ void EntityListElement::OnUpdate(const Ares::Timestep& ts)
 			}
 		}
 
-		// Remove keys from the local map that are no longer in the Entity Manager map
+		// Remove keys from the local map that are no longer in the Entity Manager
 		for (auto it = m_ComponentMap.begin(); it != m_ComponentMap.end();)
 		{
-			if (componentMap.find(it->first) == componentMap.end())
+			if (liveEntities.find(it->first) == liveEntities.end())
 			{
 				it = m_ComponentMap.erase(it);
 			}
@@ -14,6 +14,6 @@ public:
 private:
 	uint32_t m_CurrentEntity;
 	Ares::ECS::Scene* m_CurrentScene;
-	std::unordered_map<uint32_t, std::vector<std::type_index>> m_ComponentMap;
+	std::unordered_map<uint32_t, std::vector<Ares::ECS::ComponentTypeID>> m_ComponentMap;
 	std::unordered_map<uint32_t, glm::vec3> m_EntityRotations;
 };
\ No newline at end of file